@@ -1,4 +1,23 @@
 #include "widgets/screen.h"
+#include "widgets/panel.h"
+#if IS_ENABLED(CONFIG_NICE_OLED_ENGINE_DIRECT)
+#include "widgets/fb.h"
+#endif
+#if IS_ENABLED(CONFIG_NICE_OLED_DIMMING)
+#include "widgets/brightness.h"
+#endif
+#if IS_ENABLED(CONFIG_NICE_OLED_FLUSH_HOOK)
+#include "widgets/flush.h"
+#endif
+#if IS_ENABLED(CONFIG_NICE_OLED_RENDER_STATS)
+#include "widgets/render_stats.h"
+#endif
+#if IS_ENABLED(CONFIG_NICE_OLED_BOOT_TIMING)
+#include "widgets/boot_timing.h"
+#endif
+#if IS_ENABLED(CONFIG_NICE_OLED_TICKLESS)
+#include "widgets/lvgl_service.h"
+#endif
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
@@ -16,12 +35,35 @@ static struct zmk_widget_screen screen_widget;
 
 lv_obj_t *zmk_display_status_screen() {
     lv_obj_t *screen;
+#if IS_ENABLED(CONFIG_NICE_OLED_BOOT_TIMING)
+    boot_timing_start();
+#endif
     screen = lv_obj_create(NULL);
 
 #if IS_ENABLED(CONFIG_NICE_VIEW_WIDGET_STATUS)
+    panel_apply_orientation();
+#if IS_ENABLED(CONFIG_NICE_OLED_ENGINE_DIRECT)
+    fb_init();
+#endif
     zmk_widget_screen_init(&screen_widget, screen);
     lv_obj_align(zmk_widget_screen_obj(&screen_widget), LV_ALIGN_TOP_LEFT, 0, 0);
 #endif
 
+#if IS_ENABLED(CONFIG_NICE_OLED_DIMMING)
+    brightness_init();
+#endif
+
+#if IS_ENABLED(CONFIG_NICE_OLED_FLUSH_HOOK)
+    flush_hook_init();
+#endif
+
+#if IS_ENABLED(CONFIG_NICE_OLED_RENDER_STATS)
+    render_stats_init();
+#endif
+
+#if IS_ENABLED(CONFIG_NICE_OLED_TICKLESS)
+    lvgl_service_init();
+#endif
+
     return screen;
 }
@@ -9,9 +9,26 @@
 #include <lvgl.h>
 #include <zephyr/kernel.h>
 
+// One state per override too, so switching between two of them re-sources the frames
+enum anim_state {
+    ANIM_NONE,
+    ANIM_IDLE,
+    ANIM_SLOW,
+    ANIM_MID,
+    ANIM_FAST,
+    ANIM_BARK,
+    ANIM_MOD_SIT,
+    ANIM_MOD_WALK,
+    ANIM_MOD_RUN,
+    ANIM_MOD_SNEAK
+};
+
 struct zmk_widget_luna {
     sys_snode_t node;
     lv_obj_t *obj;
+    enum anim_state anim_state;
+    // Version of the status the animation was last chosen from
+    atomic_val_t version;
 };
 
 int zmk_widget_luna_init(struct zmk_widget_luna *widget, lv_obj_t *parent);
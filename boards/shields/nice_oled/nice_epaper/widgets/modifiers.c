@@ -10,11 +10,11 @@
  
  #include <zmk/display.h>
  #include <zmk/event_manager.h>
- #include <zmk/events/keycode_state_changed.h>
  #include <zmk/hid.h>
  #include <dt-bindings/zmk/modifiers.h>
  
  #include "modifiers.h"
+ #include "mods_changed.h"
  
  struct modifiers_state {
      uint8_t modifiers;
@@ -51,15 +51,16 @@
   * Returns the current modifier state
   */
  static struct modifiers_state modifiers_get_state(const zmk_event_t *eh) {
+     const struct nice_oled_mods_changed *ev = as_nice_oled_mods_changed(eh);
      return (struct modifiers_state){
-         .modifiers = zmk_hid_get_explicit_mods(),
+         .modifiers = ev ? ev->mods : zmk_hid_get_explicit_mods(),
      };
  }
  
  /* Register update hooks and subscriptions */
  ZMK_DISPLAY_WIDGET_LISTENER(widget_modifiers, struct modifiers_state,
                              modifiers_update_cb, modifiers_get_state)
- ZMK_SUBSCRIPTION(widget_modifiers, zmk_keycode_state_changed);
+ ZMK_SUBSCRIPTION(widget_modifiers, nice_oled_mods_changed);
  
  /**
   * Initialize the modifier label widget
@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+
+#include <zmk/event_manager.h>
+#include <zmk/events/keycode_state_changed.h>
+#include <zmk/hid.h>
+
+#include "mods_changed.h"
+
+ZMK_EVENT_IMPL(nice_oled_mods_changed);
+
+static atomic_t last_mods;
+
+uint8_t nice_oled_mods_get(void) { return (uint8_t)atomic_get(&last_mods); }
+
+/*
+ * Runs in the event manager context on every key, so all it does is compare
+ * one byte. Like the widget listeners it replaces, it reads the modifiers
+ * after the HID listener has applied the key to the report.
+ */
+static int mods_changed_listener(const zmk_event_t *eh) {
+    uint8_t mods = zmk_hid_get_explicit_mods();
+    if (atomic_set(&last_mods, mods) != mods) {
+        raise_nice_oled_mods_changed((struct nice_oled_mods_changed){.mods = mods});
+    }
+
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+ZMK_LISTENER(nice_oled_mods_changed_tracker, mods_changed_listener);
+ZMK_SUBSCRIPTION(nice_oled_mods_changed_tracker, zmk_keycode_state_changed);
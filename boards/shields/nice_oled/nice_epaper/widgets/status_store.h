@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+
+/*
+ * Status shared between event handlers, which may run on any thread, and
+ * the display work queue. Each field is an atomic on its own, so a reader
+ * never sees a torn value; a copy of several fields is not guaranteed to
+ * come from one moment. Every change bumps the version after storing the
+ * field, so a reader can tell whether anything changed since its last copy.
+ */
+
+#define STATUS_STORE_FIELDS 4
+
+struct status_store {
+    atomic_t version;
+    atomic_t fields[STATUS_STORE_FIELDS];
+};
+
+static inline void status_store_set(struct status_store *store, int field, atomic_val_t value) {
+    if (atomic_set(&store->fields[field], value) != value) {
+        atomic_inc(&store->version);
+    }
+}
+
+/*
+ * Copy all fields into `out` and return the version read before them. The
+ * fields are at least as new as that version; a write landing during the copy
+ * shows up as a newer version next time.
+ */
+static inline atomic_val_t status_store_snapshot(const struct status_store *store,
+                                                 atomic_val_t out[STATUS_STORE_FIELDS]) {
+    atomic_val_t version = atomic_get(&store->version);
+
+    for (int i = 0; i < STATUS_STORE_FIELDS; i++) {
+        out[i] = atomic_get(&store->fields[i]);
+    }
+    return version;
+}
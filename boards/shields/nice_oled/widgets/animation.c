@@ -1,4 +1,5 @@
 #include "animation.h"
+#include "draw.h"
 #include "screen_peripheral.h"
 // TODO: (Feature request) Disable animation when on battery #4
 // #include "../assets/custom_fonts.h"
@@ -74,27 +75,18 @@ void draw_animation(lv_obj_t *canvas, struct zmk_widget_screen *widget) {}
 void draw_animation(lv_obj_t *canvas, struct zmk_widget_screen *widget) {
     /* Declare globally within the function, so that they exist regardless of
      * #if. */
-    lv_obj_t *art = NULL;
-    lv_obj_t *art2 = NULL;
+    sprite_t *art = NULL;
+    sprite_t *art2 = NULL;
 
 #if IS_ENABLED(CONFIG_NICE_OLED_GEM_ANIMATION)
-    art = lv_animimg_create(widget->obj);
-    lv_obj_center(art);
-
-    lv_animimg_set_src(art, (const void **)crystal_imgs, 16);
-    lv_animimg_set_duration(art, CONFIG_NICE_OLED_GEM_ANIMATION_MS);
-    lv_animimg_set_repeat_count(art, LV_ANIM_REPEAT_INFINITE);
-    lv_animimg_start(art);
+    art = sprite_create(widget->obj);
+    sprite_play(art, crystal_imgs, 16, CONFIG_NICE_OLED_GEM_ANIMATION_MS, BUS_PRIORITY_DECORATION);
 
 #elif IS_ENABLED(CONFIG_NICE_OLED_POKEMON_ANIMATION)
     /* If we have the Pokémon animation enabled */
-    art = lv_animimg_create(widget->obj);
-    lv_obj_center(art);
-
-    lv_animimg_set_src(art, (const void **)pokemon_imgs, 20);
-    lv_animimg_set_duration(art, CONFIG_NICE_OLED_POKEMON_ANIMATION_MS);
-    lv_animimg_set_repeat_count(art, LV_ANIM_REPEAT_INFINITE);
-    lv_animimg_start(art);
+    art = sprite_create(widget->obj);
+    sprite_play(art, pokemon_imgs, 20, CONFIG_NICE_OLED_POKEMON_ANIMATION_MS,
+                BUS_PRIORITY_DECORATION);
 
 #else
     /* If we do not want animation (for example, config nice oled gem animation
@@ -108,41 +100,41 @@ void draw_animation(lv_obj_t *canvas, struct zmk_widget_screen *widget) {
     srand(k_uptime_get_32());
     int random_index = rand() % length;
 
-    art = lv_img_create(widget->obj);
-    lv_img_set_src(art, crystal_imgs[random_index]);
+    art = sprite_create(widget->obj);
+    sprite_show(art, crystal_imgs[random_index]);
 #endif
 
 #if IS_ENABLED(CONFIG_NICE_OLED_VIM)
     /* Additional fixed image example */
-    art2 = lv_img_create(widget->obj);
-    lv_img_set_src(art2, FIXED_IMAGE_1);
+    art2 = sprite_create(widget->obj);
+    sprite_show(art2, FIXED_IMAGE_1);
 #endif
 
 #if IS_ENABLED(CONFIG_NICE_OLED_VIP_MARCOS)
     /* Another additional fixed image */
     if (!art2) {
-        art2 = lv_img_create(widget->obj);
+        art2 = sprite_create(widget->obj);
     }
-    lv_img_set_src(art2, FIXED_IMAGE_2);
+    sprite_show(art2, FIXED_IMAGE_2);
 #endif
 
     /* Finally, we position if there is something in art or art2 */
     if (art) {
 #if IS_ENABLED(CONFIG_NICE_OLED_GEM_ANIMATION)
         /* coordinate adjustment if it was Gem animation */
-        lv_obj_align(art, LV_ALIGN_TOP_LEFT, 18, -18);
+        sprite_set_pos(art, 18, -18);
 #elif IS_ENABLED(CONFIG_NICE_OLED_POKEMON_ANIMATION)
         /* coordinate adjustment if it was the Pokémon animation */
-        lv_obj_align(art, LV_ALIGN_TOP_LEFT, -40, -18);
+        sprite_set_pos(art, -40, -18);
 #else
         /* Fixed image adjustment */
-        lv_obj_align(art, LV_ALIGN_TOP_LEFT, 18, -18);
+        sprite_set_pos(art, 18, -18);
 #endif
     }
 
     if (art2) {
         /* Second image coordinate adjustment */
-        lv_obj_align(art2, LV_ALIGN_TOP_LEFT, 2, 0);
+        sprite_set_pos(art2, 2, 0);
     }
 }
 #endif
@@ -4,31 +4,26 @@
 
 LV_IMG_DECLARE(bolt);
 
-static void draw_level(lv_obj_t *canvas, const struct status_state *state) {
-    lv_draw_label_dsc_t label_right_dsc;
-    init_label_dsc(&label_right_dsc, LVGL_FOREGROUND, &pixel_operator_mono, LV_TEXT_ALIGN_LEFT);
-
+static void draw_level(draw_target_t *canvas, const lv_area_t *area,
+                       const struct draw_dscs *dscs, const struct status_state *state) {
     char text[10] = {};
     sprintf(text, "%i%%", state->battery);
-    lv_canvas_draw_text(canvas, 0, 50, 42, &label_right_dsc, text);
+    draw_label(canvas, area->x1, area->y1, lv_area_get_width(area), &dscs->label, text);
 }
 
-static void draw_charging_level(lv_obj_t *canvas, const struct status_state *state) {
-    lv_draw_img_dsc_t img_dsc;
-    lv_draw_img_dsc_init(&img_dsc);
-    lv_draw_label_dsc_t label_right_dsc;
-    init_label_dsc(&label_right_dsc, LVGL_FOREGROUND, &pixel_operator_mono, LV_TEXT_ALIGN_LEFT);
-
+static void draw_charging_level(draw_target_t *canvas, const lv_area_t *area,
+                                const struct draw_dscs *dscs, const struct status_state *state) {
     char text[10] = {};
     sprintf(text, "%i", state->battery);
-    lv_canvas_draw_text(canvas, 0, 50, 35, &label_right_dsc, text);
-    lv_canvas_draw_img(canvas, 25, 50, &bolt, &img_dsc);
+    draw_label(canvas, area->x1, area->y1, 35, &dscs->label, text);
+    draw_img(canvas, area->x1 + 25, area->y1, &bolt, &dscs->img);
 }
 
-void draw_battery_status(lv_obj_t *canvas, const struct status_state *state) {
+void draw_battery_status(draw_target_t *canvas, const lv_area_t *area,
+                         const struct draw_dscs *dscs, const struct status_state *state) {
     if (state->charging) {
-        draw_charging_level(canvas, state);
+        draw_charging_level(canvas, area, dscs, state);
     } else {
-        draw_level(canvas, state);
+        draw_level(canvas, area, dscs, state);
     }
 }
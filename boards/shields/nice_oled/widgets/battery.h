@@ -9,4 +9,5 @@ struct battery_status_state {
     bool usb_present;
 #endif
 };
-void draw_battery_status(lv_obj_t *canvas, const struct status_state *state);
+void draw_battery_status(draw_target_t *canvas, const lv_area_t *area,
+                         const struct draw_dscs *dscs, const struct status_state *state);
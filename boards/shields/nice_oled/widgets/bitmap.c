@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <string.h>
+#include <zephyr/sys/util.h>
+
+#include "bitmap.h"
+
+// The n leftmost pixels of a 32 pixel word
+static inline uint32_t left_mask(int n) { return n >= 32 ? UINT32_MAX : ~(UINT32_MAX >> n); }
+
+// Up to 32 pixels starting at pixel `bit` of `row`, left aligned
+static uint32_t read_bits(const uint8_t *row, int bit, int n) {
+    const uint8_t *p = &row[bit / 8];
+    int off = bit % 8;
+    int bytes = (off + n + 7) / 8;
+    uint64_t v = 0;
+
+    for (int i = 0; i < bytes; i++) {
+        v |= (uint64_t)p[i] << (56 - 8 * i);
+    }
+
+    return (uint32_t)((v << off) >> 32) & left_mask(n);
+}
+
+// Combine n left aligned pixels into `row` from pixel `bit` on
+static void write_bits(uint8_t *row, int bit, int n, uint32_t bits, enum bitmap_op op) {
+    uint8_t *p = &row[bit / 8];
+    int off = bit % 8;
+    int bytes = (off + n + 7) / 8;
+    uint64_t val = (uint64_t)bits << (32 - off);
+    uint64_t mask = (uint64_t)left_mask(n) << (32 - off);
+
+    for (int i = 0; i < bytes; i++) {
+        uint8_t m = mask >> (56 - 8 * i);
+        uint8_t v = val >> (56 - 8 * i);
+
+        switch (op) {
+        case BITMAP_COPY:
+            p[i] = (p[i] & ~m) | (v & m);
+            break;
+        case BITMAP_COPY_INV:
+            p[i] = (p[i] & ~m) | (~v & m);
+            break;
+        case BITMAP_OR:
+            p[i] |= v & m;
+            break;
+        case BITMAP_CLEAR:
+            p[i] &= ~(v & m);
+            break;
+        }
+    }
+}
+
+void bitmap_fill(uint8_t *dst, size_t stride, int x, int y, int w, int h, bool set) {
+    if (w <= 0 || h <= 0) {
+        return;
+    }
+
+    int first = x / 8;
+    int last = (x + w - 1) / 8;
+    uint8_t head = 0xFF >> (x % 8);
+    uint8_t tail = 0xFF << (7 - (x + w - 1) % 8);
+
+    for (int row = y; row < y + h; row++) {
+        uint8_t *p = &dst[row * stride];
+
+        if (first == last) {
+            uint8_t m = head & tail;
+            p[first] = set ? p[first] | m : p[first] & ~m;
+            continue;
+        }
+
+        p[first] = set ? p[first] | head : p[first] & ~head;
+        memset(&p[first + 1], set ? 0xFF : 0x00, last - first - 1);
+        p[last] = set ? p[last] | tail : p[last] & ~tail;
+    }
+}
+
+void bitmap_blit(uint8_t *dst, size_t dst_stride, int dx, int dy, const uint8_t *src,
+                 size_t src_stride, int sx, int sy, int w, int h, enum bitmap_op op) {
+    for (int row = 0; row < h; row++) {
+        const uint8_t *s = &src[(sy + row) * src_stride];
+        uint8_t *d = &dst[(dy + row) * dst_stride];
+
+        for (int x = 0; x < w; x += 32) {
+            int n = MIN(32, w - x);
+            write_bits(d, dx + x, n, read_bits(s, sx + x, n), op);
+        }
+    }
+}
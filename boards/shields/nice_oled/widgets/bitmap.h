@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Kernels for packed 1bpp bitmaps with rows of `stride` bytes and the
+ * leftmost pixel in the most significant bit, the layout of LVGL's 1 bit
+ * images and fonts and of horizontally tiled panels. They work on up to 32
+ * pixels per step instead of one. Callers clip; every rectangle passed in
+ * must lie inside its bitmap.
+ */
+
+enum bitmap_op {
+    // dst = src
+    BITMAP_COPY,
+    // dst = ~src, for images whose palette is the other way round
+    BITMAP_COPY_INV,
+    // dst |= src, src set pixels are drawn, the rest is transparent
+    BITMAP_OR,
+    // dst &= ~src, src set pixels are erased, the rest is transparent
+    BITMAP_CLEAR,
+};
+
+// Set or clear a w x h rectangle.
+void bitmap_fill(uint8_t *dst, size_t stride, int x, int y, int w, int h, bool set);
+
+// Combine the w x h rectangle at (sx, sy) of `src` into `dst` at (dx, dy).
+void bitmap_blit(uint8_t *dst, size_t dst_stride, int dx, int dy, const uint8_t *src,
+                 size_t src_stride, int sx, int sy, int w, int h, enum bitmap_op op);
@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include "boot_timing.h"
+
+static uint32_t start_ms;
+static uint32_t start_cycles;
+static bool started;
+static bool done;
+
+void boot_timing_start(void) {
+    start_ms = k_uptime_get_32();
+    start_cycles = k_cycle_get_32();
+    started = true;
+}
+
+void boot_timing_flushed(void) {
+    if (!started || done) {
+        return;
+    }
+    done = true;
+
+    uint32_t us = k_cyc_to_us_floor32(k_cycle_get_32() - start_cycles);
+    LOG_INF("First frame at %u ms uptime, %u.%03u ms after the status screen (created at %u ms)",
+            k_uptime_get_32(), us / 1000, us % 1000, start_ms);
+}
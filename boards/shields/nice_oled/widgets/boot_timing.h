@@ -0,0 +1,18 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+/*
+ * Time to first frame: from the creation of the status screen to the end of
+ * the first flush to the panel, logged once per boot with both timestamps.
+ */
+
+// Called when zmk_display_status_screen() starts building the screen.
+void boot_timing_start(void);
+
+// Called after every completed write to the panel, only the first one counts.
+void boot_timing_flushed(void);
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/display.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <zmk/display.h>
+#include <zmk/event_manager.h>
+#include <zmk/events/position_state_changed.h>
+
+#include "brightness.h"
+#include "frame_dedup.h"
+
+#define CONTRAST_FULL CONFIG_NICE_OLED_DIMMING_CONTRAST_FULL
+#define CONTRAST_DIM CONFIG_NICE_OLED_DIMMING_CONTRAST_DIM
+#define FADE_STEPS CONFIG_NICE_OLED_DIMMING_FADE_STEPS
+#define FADE_STEP_MS CONFIG_NICE_OLED_DIMMING_FADE_STEP_MS
+#define DIM_TIMEOUT_MS CONFIG_NICE_OLED_DIMMING_DIM_TIMEOUT_MS
+#define OFF_TIMEOUT_MS CONFIG_NICE_OLED_DIMMING_OFF_TIMEOUT_MS
+
+#define FADE_STEP MAX(1, (CONTRAST_FULL - CONTRAST_DIM) / FADE_STEPS)
+
+BUILD_ASSERT(OFF_TIMEOUT_MS == 0 || OFF_TIMEOUT_MS > DIM_TIMEOUT_MS,
+             "CONFIG_NICE_OLED_DIMMING_OFF_TIMEOUT_MS must be 0 or longer than the dim timeout");
+
+static const struct device *display = DEVICE_DT_GET(DT_CHOSEN(zephyr_display));
+
+static atomic_t state = ATOMIC_INIT(BRIGHTNESS_FULL);
+static uint8_t contrast = CONTRAST_FULL;
+static uint8_t contrast_target = CONTRAST_FULL;
+// Cleared at init when the panel driver has no contrast control
+static bool contrast_supported = true;
+
+static void fade_cb(struct k_work *work);
+static void idle_cb(struct k_work *work);
+static void wake_cb(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(fade_work, fade_cb);
+static K_WORK_DELAYABLE_DEFINE(idle_work, idle_cb);
+static K_WORK_DEFINE(wake_work, wake_cb);
+
+// Drivers without the call answer -ENOSYS, ls0xx stubs it with -ENOTSUP
+static bool contrast_unsupported(int ret) { return ret == -ENOTSUP || ret == -ENOSYS; }
+
+static int set_contrast(uint8_t level) {
+    int ret = display_set_contrast(display, level);
+    if (ret < 0 && !contrast_unsupported(ret)) {
+        LOG_WRN("Failed to set display contrast (%d)", ret);
+    }
+    contrast = level;
+    return ret;
+}
+
+static void fade_to(uint8_t target) {
+    contrast_target = target;
+    if (!contrast_supported) {
+        contrast = target;
+        return;
+    }
+    k_work_reschedule_for_queue(zmk_display_work_q(), &fade_work, K_NO_WAIT);
+}
+
+static void fade_cb(struct k_work *work) {
+    if (contrast == contrast_target) {
+        return;
+    }
+
+    if (contrast < contrast_target) {
+        set_contrast(MIN(contrast + FADE_STEP, contrast_target));
+    } else {
+        set_contrast(MAX(contrast - FADE_STEP, contrast_target));
+    }
+
+    if (contrast != contrast_target) {
+        k_work_reschedule_for_queue(zmk_display_work_q(), &fade_work, K_MSEC(FADE_STEP_MS));
+    }
+}
+
+static void idle_cb(struct k_work *work) {
+    switch (atomic_get(&state)) {
+    case BRIGHTNESS_FULL:
+        atomic_set(&state, BRIGHTNESS_DIM);
+        fade_to(CONTRAST_DIM);
+        if (OFF_TIMEOUT_MS > DIM_TIMEOUT_MS) {
+            k_work_reschedule_for_queue(zmk_display_work_q(), &idle_work,
+                                        K_MSEC(OFF_TIMEOUT_MS - DIM_TIMEOUT_MS));
+        }
+        break;
+    case BRIGHTNESS_DIM:
+        atomic_set(&state, BRIGHTNESS_OFF);
+        k_work_cancel_delayable(&fade_work);
+        display_blanking_on(display);
+        frame_dedup_reset();
+        break;
+    default:
+        break;
+    }
+}
+
+static void wake_cb(struct k_work *work) {
+    if (atomic_get(&state) == BRIGHTNESS_OFF) {
+        display_blanking_off(display);
+        frame_dedup_reset();
+    }
+    atomic_set(&state, BRIGHTNESS_FULL);
+    fade_to(CONTRAST_FULL);
+}
+
+static int brightness_listener(const zmk_event_t *eh) {
+    const struct zmk_position_state_changed *ev = as_zmk_position_state_changed(eh);
+    if (ev == NULL || !ev->state || !zmk_display_is_initialized()) {
+        return ZMK_EV_EVENT_BUBBLE;
+    }
+
+    if (atomic_get(&state) != BRIGHTNESS_FULL) {
+        k_work_submit_to_queue(zmk_display_work_q(), &wake_work);
+    }
+    k_work_reschedule_for_queue(zmk_display_work_q(), &idle_work, K_MSEC(DIM_TIMEOUT_MS));
+
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+ZMK_LISTENER(nice_oled_brightness, brightness_listener);
+ZMK_SUBSCRIPTION(nice_oled_brightness, zmk_position_state_changed);
+
+int brightness_init(void) {
+    if (!device_is_ready(display)) {
+        return -ENODEV;
+    }
+
+    if (contrast_unsupported(set_contrast(CONTRAST_FULL))) {
+        contrast_supported = false;
+        LOG_INF("Display has no contrast control, idle dimming only blanks it");
+    }
+    k_work_reschedule_for_queue(zmk_display_work_q(), &idle_work, K_MSEC(DIM_TIMEOUT_MS));
+
+    return 0;
+}
+
+enum brightness_state brightness_get_state(void) { return atomic_get(&state); }
+
+uint8_t brightness_get_contrast(void) { return contrast; }
@@ -0,0 +1,26 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/*
+ * Idle dimming through the panel contrast register. Key activity keeps the
+ * panel at full contrast; after CONFIG_NICE_OLED_DIMMING_DIM_TIMEOUT_MS it
+ * ramps down to the dim level and after CONFIG_NICE_OLED_DIMMING_OFF_TIMEOUT_MS
+ * it is blanked. Every step is a single contrast command, no pixel data.
+ */
+
+enum brightness_state {
+    BRIGHTNESS_FULL,
+    BRIGHTNESS_DIM,
+    BRIGHTNESS_OFF,
+};
+
+int brightness_init(void);
+enum brightness_state brightness_get_state(void);
+uint8_t brightness_get_contrast(void);
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <zmk/display.h>
+
+#include "bus_governor.h"
+
+#define BUDGET CONFIG_NICE_OLED_BUS_GOVERNOR_BUDGET
+#define MAX_LEVEL CONFIG_NICE_OLED_BUS_GOVERNOR_MAX_LEVEL
+#define WINDOW_MS 1000
+#define MAX_ANIMS 4
+
+struct governed_anim {
+    lv_obj_t *obj;
+    uint32_t duration_ms;
+    enum bus_priority prio;
+};
+
+static struct governed_anim anims[MAX_ANIMS];
+
+static uint32_t window_start;
+static uint32_t window_bytes;
+static uint32_t usage;
+static uint8_t level;
+
+static uint32_t scaled_duration(const struct governed_anim *anim) {
+    // Every level doubles the frame period; decoration starts at level 1 and
+    // the character one level later, so it keeps its frame rate the longest.
+    int shift = (int)level - (int)anim->prio;
+    return shift > 0 ? anim->duration_ms << shift : anim->duration_ms;
+}
+
+static struct governed_anim *find_anim(lv_obj_t *obj) {
+    for (int i = 0; i < MAX_ANIMS; i++) {
+        if (anims[i].obj == obj) {
+            return &anims[i];
+        }
+    }
+    return NULL;
+}
+
+static void anim_deleted_cb(lv_event_t *e) {
+    struct governed_anim *anim = find_anim(lv_event_get_target(e));
+    if (anim) {
+        anim->obj = NULL;
+    }
+}
+
+void bus_governor_set_duration(lv_obj_t *animimg, uint32_t duration_ms, enum bus_priority prio) {
+    struct governed_anim *anim = find_anim(animimg);
+
+    if (anim == NULL) {
+        anim = find_anim(NULL);
+        if (anim == NULL) {
+            LOG_WRN("Bus governor is full, animation runs unthrottled");
+            lv_animimg_set_duration(animimg, duration_ms);
+            return;
+        }
+        anim->obj = animimg;
+        lv_obj_add_event_cb(animimg, anim_deleted_cb, LV_EVENT_DELETE, NULL);
+    }
+
+    anim->duration_ms = duration_ms;
+    anim->prio = prio;
+    lv_animimg_set_duration(animimg, scaled_duration(anim));
+}
+
+static void apply_level_cb(struct k_work *work) {
+    for (int i = 0; i < MAX_ANIMS; i++) {
+        if (anims[i].obj == NULL) {
+            continue;
+        }
+        lv_animimg_set_duration(anims[i].obj, scaled_duration(&anims[i]));
+        lv_animimg_start(anims[i].obj);
+    }
+}
+
+static K_WORK_DEFINE(apply_level_work, apply_level_cb);
+
+static void window_cb(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(window_work, window_cb);
+
+// Close the window once it has run its course and move the level one step
+static void update_level(void) {
+    uint32_t now = k_uptime_get_32();
+    uint32_t elapsed = now - window_start;
+
+    if (elapsed < WINDOW_MS) {
+        // An idle bus sends no more flushes, so the level has to decay
+        // without them
+        if (level > 0) {
+            k_work_schedule_for_queue(zmk_display_work_q(), &window_work,
+                                      K_MSEC(WINDOW_MS - elapsed));
+        }
+        return;
+    }
+
+    usage = (uint32_t)((uint64_t)window_bytes * MSEC_PER_SEC / elapsed);
+    window_start = now;
+    window_bytes = 0;
+
+    uint8_t next = level;
+    if (usage > BUDGET && level < MAX_LEVEL) {
+        next++;
+    } else if (usage < BUDGET / 2 && level > 0) {
+        next--;
+    }
+
+    if (next != level) {
+        LOG_DBG("Display bus at %u of %u B/s, throttle level %u", usage, BUDGET, next);
+        level = next;
+        // Restarting animations is not safe from inside the flush
+        k_work_submit_to_queue(zmk_display_work_q(), &apply_level_work);
+    }
+
+    if (level > 0) {
+        k_work_schedule_for_queue(zmk_display_work_q(), &window_work, K_MSEC(WINDOW_MS));
+    }
+}
+
+static void window_cb(struct k_work *work) { update_level(); }
+
+void bus_governor_account(size_t bytes) {
+    window_bytes += bytes;
+    update_level();
+}
+
+uint32_t bus_governor_budget(void) { return BUDGET; }
+
+uint32_t bus_governor_usage(void) { return usage; }
+
+uint8_t bus_governor_level(void) { return level; }
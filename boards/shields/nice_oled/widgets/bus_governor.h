@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <lvgl.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/sys/util.h>
+
+/*
+ * Animation classes in the order they give up bus bandwidth. Status redraws
+ * are never throttled; decoration slows down first, then the character.
+ */
+enum bus_priority {
+    BUS_PRIORITY_DECORATION,
+    BUS_PRIORITY_CHARACTER,
+};
+
+#if IS_ENABLED(CONFIG_NICE_OLED_BUS_GOVERNOR)
+
+/*
+ * Set the duration of an lv_animimg through the governor. The duration is
+ * stretched while the display bus is over CONFIG_NICE_OLED_BUS_GOVERNOR_BUDGET
+ * and restored once usage drops again.
+ */
+void bus_governor_set_duration(lv_obj_t *animimg, uint32_t duration_ms, enum bus_priority prio);
+
+// Called for every flush with the number of bytes written to the panel.
+void bus_governor_account(size_t bytes);
+
+uint32_t bus_governor_budget(void);
+uint32_t bus_governor_usage(void);
+uint8_t bus_governor_level(void);
+
+#else
+
+static inline void bus_governor_set_duration(lv_obj_t *animimg, uint32_t duration_ms,
+                                             enum bus_priority prio) {
+    lv_animimg_set_duration(animimg, duration_ms);
+}
+
+#endif
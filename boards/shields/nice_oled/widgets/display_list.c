@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#include "display_list.h"
+
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+static const char *const op_names[] = {
+    [DISPLAY_OP_IMG] = "img",     [DISPLAY_OP_RECT] = "rect", [DISPLAY_OP_LINE] = "line",
+    [DISPLAY_OP_LABEL] = "label", [DISPLAY_OP_TEXT] = "text",
+};
+
+void display_list_reset(struct display_list *list, draw_backend_t *backend) {
+    list->backend = backend;
+    list->count = 0;
+    list->overflow = false;
+    list->used = 0;
+}
+
+struct display_list *display_list_begin(struct display_lists *lists, draw_backend_t *backend) {
+    struct display_list *list = &lists->frames[lists->current ^ 1];
+    display_list_reset(list, backend);
+    return list;
+}
+
+// Commands are zeroed before they are filled in, so padding compares equal too
+static bool cmd_equal(const struct display_list *a, const struct display_cmd *ca,
+                      const struct display_list *b, const struct display_cmd *cb) {
+    if (memcmp(ca, cb, offsetof(struct display_cmd, data)) != 0 ||
+        memcmp(&ca->x, &cb->x, sizeof(*ca) - offsetof(struct display_cmd, x)) != 0) {
+        return false;
+    }
+
+    size_t size = ca->op == DISPLAY_OP_LINE ? ca->len * sizeof(lv_point_t) : ca->len;
+    return memcmp(&a->data[ca->data], &b->data[cb->data], size) == 0;
+}
+
+bool display_list_commit(struct display_lists *lists) {
+    const struct display_list *prev = &lists->frames[lists->current];
+    const struct display_list *next = &lists->frames[lists->current ^ 1];
+    bool changed = prev->count != next->count || prev->overflow || next->overflow ||
+                   prev->backend != next->backend;
+
+    for (int i = 0; i < MIN(prev->count, next->count); i++) {
+        if (!cmd_equal(prev, &prev->cmds[i], next, &next->cmds[i])) {
+            LOG_DBG("display list: cmd %d (%s) changed", i, op_names[next->cmds[i].op]);
+            changed = true;
+        }
+    }
+
+    // An unchanged frame is dropped, the previous one stays the reference
+    if (changed) {
+        lists->current ^= 1;
+        display_list_dump(next);
+    }
+    return changed;
+}
+
+void display_list_replay(const struct display_list *list) {
+    for (int i = 0; i < list->count; i++) {
+        const struct display_cmd *cmd = &list->cmds[i];
+        const void *data = &list->data[cmd->data];
+
+        switch (cmd->op) {
+        case DISPLAY_OP_IMG:
+            backend_draw_img(list->backend, cmd->x, cmd->y, cmd->src, cmd->dsc);
+            break;
+        case DISPLAY_OP_RECT:
+            backend_draw_rect(list->backend, cmd->x, cmd->y, cmd->w, cmd->h, cmd->dsc);
+            break;
+        case DISPLAY_OP_LINE:
+            backend_draw_line(list->backend, data, cmd->len, cmd->dsc);
+            break;
+        case DISPLAY_OP_LABEL:
+            backend_draw_label(list->backend, cmd->x, cmd->y, cmd->w, cmd->dsc, data);
+            break;
+        case DISPLAY_OP_TEXT:
+            backend_draw_text(list->backend, cmd->x, cmd->y, cmd->w, cmd->dsc, data);
+            break;
+        }
+    }
+}
+
+void display_list_dump(const struct display_list *list) {
+    if (!IS_ENABLED(CONFIG_ZMK_LOG_LEVEL_DBG)) {
+        return;
+    }
+
+    LOG_DBG("display list: %d cmds, %d data bytes%s", list->count, list->used,
+            list->overflow ? ", overflowed" : "");
+    for (int i = 0; i < list->count; i++) {
+        const struct display_cmd *cmd = &list->cmds[i];
+        if (cmd->op == DISPLAY_OP_LABEL || cmd->op == DISPLAY_OP_TEXT) {
+            LOG_DBG("  %2d %-5s (%d, %d) w %d \"%s\"", i, op_names[cmd->op], cmd->x, cmd->y,
+                    cmd->w, (const char *)&list->data[cmd->data]);
+        } else {
+            LOG_DBG("  %2d %-5s (%d, %d) %dx%d n %d", i, op_names[cmd->op], cmd->x, cmd->y,
+                    cmd->w, cmd->h, cmd->len);
+        }
+    }
+}
+
+static struct display_cmd *append(struct display_list *list, enum display_op op, const void *data,
+                                  size_t size) {
+    if (list->count == ARRAY_SIZE(list->cmds) || list->used + size > sizeof(list->data)) {
+        if (!list->overflow) {
+            LOG_WRN("display list full, dropping %s", op_names[op]);
+        }
+        list->overflow = true;
+        return NULL;
+    }
+
+    struct display_cmd *cmd = &list->cmds[list->count++];
+    memset(cmd, 0, sizeof(*cmd));
+    cmd->op = op;
+    cmd->data = list->used;
+    if (size > 0) {
+        memcpy(&list->data[list->used], data, size);
+        // Keep line points aligned for the backend
+        list->used += ROUND_UP(size, sizeof(lv_coord_t));
+    }
+    return cmd;
+}
+
+void display_list_img(struct display_list *list, lv_coord_t x, lv_coord_t y,
+                      const lv_img_dsc_t *img, const lv_draw_img_dsc_t *dsc) {
+    struct display_cmd *cmd = append(list, DISPLAY_OP_IMG, NULL, 0);
+    if (cmd != NULL) {
+        cmd->x = x;
+        cmd->y = y;
+        cmd->src = img;
+        cmd->dsc = dsc;
+    }
+}
+
+void display_list_rect(struct display_list *list, lv_coord_t x, lv_coord_t y, lv_coord_t w,
+                       lv_coord_t h, const lv_draw_rect_dsc_t *dsc) {
+    struct display_cmd *cmd = append(list, DISPLAY_OP_RECT, NULL, 0);
+    if (cmd != NULL) {
+        cmd->x = x;
+        cmd->y = y;
+        cmd->w = w;
+        cmd->h = h;
+        cmd->dsc = dsc;
+    }
+}
+
+void display_list_line(struct display_list *list, const lv_point_t points[], uint32_t count,
+                       const lv_draw_line_dsc_t *dsc) {
+    count = MIN(count, UINT8_MAX);
+    struct display_cmd *cmd = append(list, DISPLAY_OP_LINE, points, count * sizeof(lv_point_t));
+    if (cmd != NULL) {
+        cmd->len = count;
+        cmd->dsc = dsc;
+    }
+}
+
+void display_list_text(struct display_list *list, enum display_op op, lv_coord_t x, lv_coord_t y,
+                       lv_coord_t max_w, const lv_draw_label_dsc_t *dsc, const char *txt) {
+    size_t size = MIN(strlen(txt) + 1, UINT8_MAX);
+    struct display_cmd *cmd = append(list, op, txt, size);
+    if (cmd != NULL) {
+        list->data[cmd->data + size - 1] = '\0';
+        cmd->len = size;
+        cmd->x = x;
+        cmd->y = y;
+        cmd->w = max_w;
+        cmd->dsc = dsc;
+    }
+}
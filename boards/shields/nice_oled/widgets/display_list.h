@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <lvgl.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <zephyr/toolchain.h>
+
+#include "draw_backend.h"
+
+/*
+ * Display list of one status frame. With CONFIG_NICE_OLED_DISPLAY_LIST the
+ * draw_*() calls of the widgets only append commands here; the screen then
+ * compares the frame with the previous one and replays it on the backend only
+ * when a command differs, so an update that changes nothing touches no pixel.
+ *
+ * Commands hold their inputs by value (coordinates, text, line points) or by
+ * pointer to data that lives as long as the screen (images, descriptors).
+ */
+
+#define DISPLAY_LIST_CMDS 24
+#define DISPLAY_LIST_DATA 160
+
+enum display_op {
+    DISPLAY_OP_IMG,
+    DISPLAY_OP_RECT,
+    DISPLAY_OP_LINE,
+    DISPLAY_OP_LABEL,
+    DISPLAY_OP_TEXT,
+};
+
+struct display_cmd {
+    uint8_t op;
+    // Bytes of text or number of points in the data pool, starting at `data`
+    uint8_t len;
+    uint16_t data;
+    lv_coord_t x;
+    lv_coord_t y;
+    // Rect size, or max_w of text
+    lv_coord_t w;
+    lv_coord_t h;
+    const void *src;
+    const void *dsc;
+};
+
+struct display_list {
+    draw_backend_t *backend;
+    uint8_t count;
+    bool overflow;
+    uint16_t used;
+    struct display_cmd cmds[DISPLAY_LIST_CMDS];
+    uint8_t data[DISPLAY_LIST_DATA] __aligned(sizeof(lv_coord_t));
+};
+
+// The frame being recorded and the one on the backend.
+struct display_lists {
+    struct display_list frames[2];
+    uint8_t current;
+};
+
+void display_list_reset(struct display_list *list, draw_backend_t *backend);
+
+// Start recording a frame for `backend` and return the list to draw into.
+struct display_list *display_list_begin(struct display_lists *lists, draw_backend_t *backend);
+
+/*
+ * Finish the frame being recorded. Returns true when it differs from the
+ * previous one and has to be replayed.
+ */
+bool display_list_commit(struct display_lists *lists);
+
+void display_list_replay(const struct display_list *list);
+
+// Log every command of a frame
+void display_list_dump(const struct display_list *list);
+
+void display_list_img(struct display_list *list, lv_coord_t x, lv_coord_t y,
+                      const lv_img_dsc_t *img, const lv_draw_img_dsc_t *dsc);
+void display_list_rect(struct display_list *list, lv_coord_t x, lv_coord_t y, lv_coord_t w,
+                       lv_coord_t h, const lv_draw_rect_dsc_t *dsc);
+void display_list_line(struct display_list *list, const lv_point_t points[], uint32_t count,
+                       const lv_draw_line_dsc_t *dsc);
+void display_list_text(struct display_list *list, enum display_op op, lv_coord_t x, lv_coord_t y,
+                       lv_coord_t max_w, const lv_draw_label_dsc_t *dsc, const char *txt);
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <lvgl.h>
+#include <zephyr/sys/util.h>
+
+#include "draw_backend.h"
+
+/*
+ * Thin drawing interface the widgets draw through. A target is the backend
+ * from draw_backend.h itself, or with CONFIG_NICE_OLED_DISPLAY_LIST a display
+ * list that records the calls for display_list_replay(). Everything is
+ * resolved at compile time.
+ */
+
+#if IS_ENABLED(CONFIG_NICE_OLED_DISPLAY_LIST)
+
+#include "display_list.h"
+
+typedef struct display_list draw_target_t;
+
+static inline draw_backend_t *draw_target_backend(draw_target_t *target) {
+    return target->backend;
+}
+
+static inline void draw_img(draw_target_t *target, lv_coord_t x, lv_coord_t y,
+                            const lv_img_dsc_t *img, const lv_draw_img_dsc_t *dsc) {
+    display_list_img(target, x, y, img, dsc);
+}
+
+static inline void draw_rect(draw_target_t *target, lv_coord_t x, lv_coord_t y, lv_coord_t w,
+                             lv_coord_t h, const lv_draw_rect_dsc_t *dsc) {
+    display_list_rect(target, x, y, w, h, dsc);
+}
+
+static inline void draw_line(draw_target_t *target, const lv_point_t points[], uint32_t count,
+                             const lv_draw_line_dsc_t *dsc) {
+    display_list_line(target, points, count, dsc);
+}
+
+static inline void draw_label(draw_target_t *target, lv_coord_t x, lv_coord_t y, lv_coord_t max_w,
+                              const lv_draw_label_dsc_t *dsc, const char *txt) {
+    display_list_text(target, DISPLAY_OP_LABEL, x, y, max_w, dsc, txt);
+}
+
+static inline void draw_text(draw_target_t *target, lv_coord_t x, lv_coord_t y, lv_coord_t max_w,
+                             const lv_draw_label_dsc_t *dsc, const char *txt) {
+    display_list_text(target, DISPLAY_OP_TEXT, x, y, max_w, dsc, txt);
+}
+
+#else
+
+typedef draw_backend_t draw_target_t;
+
+static inline draw_backend_t *draw_target_backend(draw_target_t *target) { return target; }
+
+static inline void draw_img(draw_target_t *target, lv_coord_t x, lv_coord_t y,
+                            const lv_img_dsc_t *img, const lv_draw_img_dsc_t *dsc) {
+    backend_draw_img(target, x, y, img, dsc);
+}
+
+static inline void draw_rect(draw_target_t *target, lv_coord_t x, lv_coord_t y, lv_coord_t w,
+                             lv_coord_t h, const lv_draw_rect_dsc_t *dsc) {
+    backend_draw_rect(target, x, y, w, h, dsc);
+}
+
+static inline void draw_line(draw_target_t *target, const lv_point_t points[], uint32_t count,
+                             const lv_draw_line_dsc_t *dsc) {
+    backend_draw_line(target, points, count, dsc);
+}
+
+// Cached: for labels that repeat, like the battery level or layer name
+static inline void draw_label(draw_target_t *target, lv_coord_t x, lv_coord_t y, lv_coord_t max_w,
+                              const lv_draw_label_dsc_t *dsc, const char *txt) {
+    backend_draw_label(target, x, y, max_w, dsc, txt);
+}
+
+// Uncached: for values that rarely repeat
+static inline void draw_text(draw_target_t *target, lv_coord_t x, lv_coord_t y, lv_coord_t max_w,
+                             const lv_draw_label_dsc_t *dsc, const char *txt) {
+    backend_draw_text(target, x, y, max_w, dsc, txt);
+}
+
+#endif
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <lvgl.h>
+#include <zephyr/sys/util.h>
+
+#include "bus_governor.h"
+
+/*
+ * What the drawing interface in draw.h ends up drawing on. By default a
+ * backend is the LVGL canvas and a sprite an lv_animimg; with
+ * CONFIG_NICE_OLED_ENGINE_DIRECT both are backed by the direct 1bpp engine in
+ * fb.c. Everything is resolved at compile time.
+ */
+
+#if IS_ENABLED(CONFIG_NICE_OLED_ENGINE_DIRECT)
+
+#include "fb.h"
+
+typedef struct fb draw_backend_t;
+typedef struct fb_sprite sprite_t;
+
+static inline void backend_draw_img(draw_backend_t *target, lv_coord_t x, lv_coord_t y,
+                                    const lv_img_dsc_t *img, const lv_draw_img_dsc_t *dsc) {
+    fb_blit_img(target, x, y, img);
+}
+
+static inline void backend_draw_rect(draw_backend_t *target, lv_coord_t x, lv_coord_t y,
+                                     lv_coord_t w, lv_coord_t h, const lv_draw_rect_dsc_t *dsc) {
+    fb_fill_rect(target, x, y, w, h, dsc->bg_color);
+}
+
+static inline void backend_draw_line(draw_backend_t *target, const lv_point_t points[],
+                                     uint32_t count, const lv_draw_line_dsc_t *dsc) {
+    fb_line(target, points, count, dsc->width, dsc->color);
+}
+
+static inline void backend_draw_label(draw_backend_t *target, lv_coord_t x, lv_coord_t y,
+                                      lv_coord_t max_w, const lv_draw_label_dsc_t *dsc,
+                                      const char *txt) {
+    fb_text(target, x, y, max_w, dsc->font, dsc->color, txt);
+}
+
+static inline void backend_draw_text(draw_backend_t *target, lv_coord_t x, lv_coord_t y,
+                                     lv_coord_t max_w, const lv_draw_label_dsc_t *dsc,
+                                     const char *txt) {
+    fb_text(target, x, y, max_w, dsc->font, dsc->color, txt);
+}
+
+// Redraw one area of a frame already on the display, outside of a full redraw
+static inline void backend_patch_img(draw_backend_t *target, lv_coord_t x, lv_coord_t y,
+                                     const lv_img_dsc_t *img) {
+    fb_patch_img(target, x, y, img);
+}
+
+static inline sprite_t *sprite_create(lv_obj_t *parent) { return fb_sprite_get(); }
+
+static inline void sprite_play(sprite_t *sprite, const lv_img_dsc_t *const *frames, uint8_t count,
+                               uint32_t duration_ms, enum bus_priority prio) {
+    fb_sprite_play(sprite, frames, count, duration_ms);
+}
+
+static inline void sprite_show(sprite_t *sprite, const lv_img_dsc_t *img) {
+    fb_sprite_show(sprite, img);
+}
+
+static inline void sprite_hide(sprite_t *sprite) { fb_sprite_hide(sprite); }
+
+static inline void sprite_set_pos(sprite_t *sprite, lv_coord_t x, lv_coord_t y) {
+    fb_sprite_set_pos(sprite, x, y);
+}
+
+static inline void sprite_delete(sprite_t *sprite) { fb_sprite_put(sprite); }
+
+// Sprites live in a static array, there is no heap to give back
+static inline void sprite_trim(void) {}
+
+#else
+
+#include "label_cache.h"
+#include "mono_text.h"
+#include "lvgl_service.h"
+#include "sprite_pool.h"
+
+typedef lv_obj_t draw_backend_t;
+typedef lv_obj_t sprite_t;
+
+// In util.c; writes into the drawing canvas and rotates that area into the view
+void canvas_patch_bits(lv_obj_t *canvas, lv_coord_t x, lv_coord_t y, const uint8_t *bits,
+                       lv_coord_t stride, lv_coord_t w, lv_coord_t h);
+
+static inline void backend_draw_img(draw_backend_t *target, lv_coord_t x, lv_coord_t y,
+                                    const lv_img_dsc_t *img, const lv_draw_img_dsc_t *dsc) {
+    lv_canvas_draw_img(target, x, y, img, dsc);
+}
+
+static inline void backend_draw_rect(draw_backend_t *target, lv_coord_t x, lv_coord_t y,
+                                     lv_coord_t w, lv_coord_t h, const lv_draw_rect_dsc_t *dsc) {
+    lv_canvas_draw_rect(target, x, y, w, h, dsc);
+}
+
+static inline void backend_draw_line(draw_backend_t *target, const lv_point_t points[],
+                                     uint32_t count, const lv_draw_line_dsc_t *dsc) {
+    lv_canvas_draw_line(target, points, count, dsc);
+}
+
+static inline void backend_draw_label(draw_backend_t *target, lv_coord_t x, lv_coord_t y,
+                                      lv_coord_t max_w, const lv_draw_label_dsc_t *dsc,
+                                      const char *txt) {
+    canvas_draw_label(target, x, y, max_w, dsc, txt);
+}
+
+static inline void backend_draw_text(draw_backend_t *target, lv_coord_t x, lv_coord_t y,
+                                     lv_coord_t max_w, const lv_draw_label_dsc_t *dsc,
+                                     const char *txt) {
+    canvas_draw_mono_text(target, x, y, max_w, dsc, txt);
+}
+
+// Redraw one area of a frame already on the display, outside of a full redraw.
+// `img` must be an opaque 1 bit image with the foreground at index 1.
+static inline void backend_patch_img(draw_backend_t *target, lv_coord_t x, lv_coord_t y,
+                                     const lv_img_dsc_t *img) {
+    canvas_patch_bits(target, x, y, img->data + 2 * sizeof(lv_color32_t),
+                      DIV_ROUND_UP(img->header.w, 8), img->header.w, img->header.h);
+    lvgl_service_kick();
+}
+
+// Pooled: created sprites are hidden until played or shown
+static inline sprite_t *sprite_create(lv_obj_t *parent) { return sprite_pool_get(parent); }
+
+static inline void sprite_play(sprite_t *sprite, const lv_img_dsc_t *const *frames, uint8_t count,
+                               uint32_t duration_ms, enum bus_priority prio) {
+    lv_obj_clear_flag(sprite, LV_OBJ_FLAG_HIDDEN);
+    lv_animimg_set_src(sprite, (const void **)frames, count);
+    bus_governor_set_duration(sprite, duration_ms, prio);
+    lv_animimg_set_repeat_count(sprite, LV_ANIM_REPEAT_INFINITE);
+    lv_animimg_start(sprite);
+    lvgl_service_kick();
+}
+
+// An lv_animimg is an lv_img, so it can show a still image too. Like the
+// direct engine's, showing one stops a playing animation.
+static inline void sprite_show(sprite_t *sprite, const lv_img_dsc_t *img) {
+    lv_anim_del(sprite, NULL);
+    lv_obj_clear_flag(sprite, LV_OBJ_FLAG_HIDDEN);
+    lv_img_set_src(sprite, img);
+    lvgl_service_kick();
+}
+
+// Hidden sprites keep their object but stop animating
+static inline void sprite_hide(sprite_t *sprite) {
+    lv_anim_del(sprite, NULL);
+    lv_obj_add_flag(sprite, LV_OBJ_FLAG_HIDDEN);
+    lvgl_service_kick();
+}
+
+static inline void sprite_set_pos(sprite_t *sprite, lv_coord_t x, lv_coord_t y) {
+    lv_obj_align(sprite, LV_ALIGN_TOP_LEFT, x, y);
+    lvgl_service_kick();
+}
+
+static inline void sprite_delete(sprite_t *sprite) { sprite_pool_put(sprite); }
+
+// Free the pooled objects no widget holds
+static inline void sprite_trim(void) { sprite_pool_trim(); }
+
+#endif
@@ -0,0 +1,513 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/display.h>
+#include <zephyr/kernel.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <zmk/display.h>
+
+#include "bitmap.h"
+#include "fb.h"
+#include "mono_text.h"
+#include "panel.h"
+#include "util.h"
+
+#if IS_ENABLED(CONFIG_NICE_OLED_BOOT_TIMING)
+#include "boot_timing.h"
+#endif
+
+#define FB_NODE DT_CHOSEN(zephyr_display)
+#define FB_WIDTH DT_PROP(FB_NODE, width)
+#define FB_HEIGHT DT_PROP(FB_NODE, height)
+
+// Bytes per row when the panel tiles horizontally (one bit per column)
+#define FB_STRIDE DIV_ROUND_UP(FB_WIDTH, 8)
+// Vertically tiled panels use one byte per column for every 8 rows
+#define FB_SIZE MAX(FB_STRIDE * FB_HEIGHT, DIV_ROUND_UP(FB_HEIGHT, 8) * FB_WIDTH)
+
+// Scratch space for one rasterized label
+#define TEXT_STRIDE 32
+#define TEXT_MAX_H 32
+
+struct fb_sprite {
+    struct k_work_delayable work;
+    const lv_img_dsc_t *const *frames;
+    const lv_img_dsc_t *still;
+    uint8_t count;
+    uint8_t index;
+    uint32_t frame_ms;
+    lv_coord_t x;
+    lv_coord_t y;
+    bool used;
+};
+
+struct fb {
+    const struct device *dev;
+    bool vtiled;
+    bool msb_first;
+    bool invert;
+    int16_t angle;
+    lv_point_t pivot;
+    uint8_t scene[FB_SIZE];
+    uint8_t out[FB_SIZE];
+    struct fb_sprite sprites[CONFIG_NICE_OLED_ENGINE_SPRITES];
+};
+
+static struct fb fb_state;
+
+struct fb *fb_get(void) { return &fb_state; }
+
+/** ───── Pixels ─────────────────────────────────────────── */
+
+static void fb_native_px(const struct fb *fb, uint8_t *buf, lv_coord_t x, lv_coord_t y,
+                         bool white) {
+    if (x < 0 || y < 0 || x >= FB_WIDTH || y >= FB_HEIGHT) {
+        return;
+    }
+
+    size_t idx;
+    uint8_t shift;
+    if (fb->vtiled) {
+        idx = (y / 8) * FB_WIDTH + x;
+        shift = y & 7;
+    } else {
+        idx = y * FB_STRIDE + x / 8;
+        shift = x & 7;
+    }
+    uint8_t bit = fb->msb_first ? 0x80 >> shift : 1 << shift;
+
+    // Same convention as the LVGL glue: MONO10 stores black as 1
+    if (white != fb->invert) {
+        buf[idx] |= bit;
+    } else {
+        buf[idx] &= ~bit;
+    }
+}
+
+// Map portrait canvas coordinates the way rotate_canvas() does
+static void fb_scene_px(struct fb *fb, lv_coord_t x, lv_coord_t y, bool white) {
+    lv_point_t p = rotation_map(fb->angle, fb->pivot, x, y);
+    fb_native_px(fb, fb->scene, p.x, p.y, white);
+}
+
+static inline bool color_is_white(lv_color_t color) { return color.full != 0; }
+
+/*
+ * Read one pixel of an indexed image. Returns false for transparent pixels
+ * and formats the engine does not decode.
+ */
+static bool img_px(const lv_img_dsc_t *img, lv_coord_t x, lv_coord_t y, bool *white) {
+    const lv_color32_t *palette = (const lv_color32_t *)img->data;
+    uint8_t idx;
+
+    switch (img->header.cf) {
+    case LV_IMG_CF_INDEXED_1BIT: {
+        const uint8_t *bits = img->data + 2 * sizeof(lv_color32_t);
+        uint8_t byte = bits[y * DIV_ROUND_UP(img->header.w, 8) + x / 8];
+        idx = (byte >> (7 - (x & 7))) & 0x1;
+        break;
+    }
+    case LV_IMG_CF_INDEXED_2BIT: {
+        const uint8_t *bits = img->data + 4 * sizeof(lv_color32_t);
+        uint8_t byte = bits[y * DIV_ROUND_UP(img->header.w, 4) + x / 4];
+        idx = (byte >> (6 - 2 * (x & 3))) & 0x3;
+        break;
+    }
+    default:
+        return false;
+    }
+
+    if (palette[idx].ch.alpha < LV_OPA_50) {
+        return false;
+    }
+
+    // LV_COLOR_DEPTH 1 turns any channel >= 128 into white
+    *white = (palette[idx].ch.red | palette[idx].ch.green | palette[idx].ch.blue) & 0x80;
+    return true;
+}
+
+static bool img_supported(const lv_img_dsc_t *img) {
+    if (img->header.cf == LV_IMG_CF_INDEXED_1BIT || img->header.cf == LV_IMG_CF_INDEXED_2BIT) {
+        return true;
+    }
+
+    LOG_WRN("Image format %d is not supported by the direct engine", img->header.cf);
+    return false;
+}
+
+/** ───── Scene ──────────────────────────────────────────── */
+
+void fb_clear(struct fb *fb) {
+    bool white = color_is_white(LVGL_BACKGROUND);
+    memset(fb->scene, white != fb->invert ? 0xFF : 0x00, sizeof(fb->scene));
+}
+
+void fb_fill_rect(struct fb *fb, lv_coord_t x, lv_coord_t y, lv_coord_t w, lv_coord_t h,
+                  lv_color_t color) {
+    bool white = color_is_white(color);
+
+    for (lv_coord_t py = y; py < y + h; py++) {
+        for (lv_coord_t px = x; px < x + w; px++) {
+            fb_scene_px(fb, px, py, white);
+        }
+    }
+}
+
+static void fb_segment(struct fb *fb, lv_point_t a, lv_point_t b, lv_coord_t width, bool white) {
+    lv_coord_t dx = LV_ABS(b.x - a.x);
+    lv_coord_t dy = -LV_ABS(b.y - a.y);
+    lv_coord_t sx = a.x < b.x ? 1 : -1;
+    lv_coord_t sy = a.y < b.y ? 1 : -1;
+    lv_coord_t err = dx + dy;
+    lv_coord_t lo = -(width - 1) / 2;
+    lv_coord_t hi = width / 2;
+
+    while (true) {
+        for (lv_coord_t oy = lo; oy <= hi; oy++) {
+            for (lv_coord_t ox = lo; ox <= hi; ox++) {
+                fb_scene_px(fb, a.x + ox, a.y + oy, white);
+            }
+        }
+
+        if (a.x == b.x && a.y == b.y) {
+            break;
+        }
+
+        lv_coord_t e2 = 2 * err;
+        if (e2 >= dy) {
+            err += dy;
+            a.x += sx;
+        }
+        if (e2 <= dx) {
+            err += dx;
+            a.y += sy;
+        }
+    }
+}
+
+void fb_line(struct fb *fb, const lv_point_t points[], uint32_t count, lv_coord_t width,
+             lv_color_t color) {
+    bool white = color_is_white(color);
+
+    for (uint32_t i = 1; i < count; i++) {
+        fb_segment(fb, points[i - 1], points[i], MAX(width, 1), white);
+    }
+}
+
+void fb_blit_img(struct fb *fb, lv_coord_t x, lv_coord_t y, const lv_img_dsc_t *img) {
+    if (!img_supported(img)) {
+        return;
+    }
+
+    for (lv_coord_t iy = 0; iy < img->header.h; iy++) {
+        for (lv_coord_t ix = 0; ix < img->header.w; ix++) {
+            bool white;
+            if (img_px(img, ix, iy, &white)) {
+                fb_scene_px(fb, x + ix, y + iy, white);
+            }
+        }
+    }
+}
+
+void fb_text(struct fb *fb, lv_coord_t x, lv_coord_t y, lv_coord_t max_w, const lv_font_t *font,
+             lv_color_t color, const char *txt) {
+    static uint8_t bits[TEXT_STRIDE * TEXT_MAX_H];
+
+    lv_coord_t width = mono_text_width(font, txt);
+    if (width < 0) {
+        LOG_WRN("Text \"%s\" can't be drawn by the direct engine", txt);
+        return;
+    }
+
+    // One spare cell for glyphs overhanging their advance; no wrapping
+    lv_coord_t w = MIN(MIN(width + 8, max_w), TEXT_STRIDE * 8);
+    lv_coord_t h = MIN(font->line_height, TEXT_MAX_H);
+    bool white = color_is_white(color);
+
+    mono_text_render(font, txt, bits, TEXT_STRIDE, w, h);
+
+    for (lv_coord_t py = 0; py < h; py++) {
+        const uint8_t *row = &bits[py * TEXT_STRIDE];
+        for (lv_coord_t px = 0; px < w; px++) {
+            if (row[px >> 3] & (0x80 >> (px & 7))) {
+                fb_scene_px(fb, x + px, y + py, white);
+            }
+        }
+    }
+}
+
+/** ───── Output ─────────────────────────────────────────── */
+
+/*
+ * A 1 bit image whose rows match a horizontally tiled, MSB first panel can
+ * be combined 32 pixels at a time; pick the op its palette amounts to.
+ */
+static bool fb_sprite_op(const struct fb *fb, const lv_img_dsc_t *img, enum bitmap_op *op) {
+    if (fb->vtiled || !fb->msb_first || img->header.cf != LV_IMG_CF_INDEXED_1BIT) {
+        return false;
+    }
+
+    const lv_color32_t *palette = (const lv_color32_t *)img->data;
+    bool opaque0 = palette[0].ch.alpha >= LV_OPA_50;
+    bool opaque1 = palette[1].ch.alpha >= LV_OPA_50;
+    bool set0 = ((palette[0].ch.red | palette[0].ch.green | palette[0].ch.blue) & 0x80) != fb->invert;
+    bool set1 = ((palette[1].ch.red | palette[1].ch.green | palette[1].ch.blue) & 0x80) != fb->invert;
+
+    if (opaque0 && opaque1 && set0 != set1) {
+        *op = set1 ? BITMAP_COPY : BITMAP_COPY_INV;
+    } else if (!opaque0 && opaque1) {
+        *op = set1 ? BITMAP_OR : BITMAP_CLEAR;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static void fb_blit_sprite(struct fb *fb, const struct fb_sprite *sprite) {
+    const lv_img_dsc_t *img = sprite->frames[sprite->index];
+    enum bitmap_op op;
+
+    if (fb_sprite_op(fb, img, &op)) {
+        lv_coord_t sx = MAX(0, -sprite->x);
+        lv_coord_t sy = MAX(0, -sprite->y);
+        lv_coord_t w = MIN(img->header.w, FB_WIDTH - sprite->x) - sx;
+        lv_coord_t h = MIN(img->header.h, FB_HEIGHT - sprite->y) - sy;
+
+        if (w > 0 && h > 0) {
+            bitmap_blit(fb->out, FB_STRIDE, sprite->x + sx, sprite->y + sy,
+                        img->data + 2 * sizeof(lv_color32_t), DIV_ROUND_UP(img->header.w, 8), sx,
+                        sy, w, h, op);
+        }
+        return;
+    }
+
+    for (lv_coord_t iy = 0; iy < img->header.h; iy++) {
+        for (lv_coord_t ix = 0; ix < img->header.w; ix++) {
+            bool white;
+            if (img_px(img, ix, iy, &white)) {
+                fb_native_px(fb, fb->out, sprite->x + ix, sprite->y + iy, white);
+            }
+        }
+    }
+}
+
+// Compose rows y1..y2 (panel coordinates) and write them out
+static void fb_write_rows(struct fb *fb, lv_coord_t y1, lv_coord_t y2) {
+    y1 = MAX(y1, 0);
+    y2 = MIN(y2, FB_HEIGHT - 1);
+    if (y1 > y2) {
+        return;
+    }
+
+    size_t offset;
+    size_t len;
+    if (fb->vtiled) {
+        // Whole pages only
+        y1 &= ~7;
+        y2 = MIN(y2 | 7, FB_HEIGHT - 1);
+        offset = (y1 / 8) * FB_WIDTH;
+        len = DIV_ROUND_UP(y2 - y1 + 1, 8) * FB_WIDTH;
+    } else {
+        offset = y1 * FB_STRIDE;
+        len = (y2 - y1 + 1) * FB_STRIDE;
+    }
+
+    memcpy(&fb->out[offset], &fb->scene[offset], len);
+    for (int i = 0; i < ARRAY_SIZE(fb->sprites); i++) {
+        const struct fb_sprite *sprite = &fb->sprites[i];
+        if (sprite->used && sprite->frames != NULL) {
+            fb_blit_sprite(fb, sprite);
+        }
+    }
+
+    struct display_buffer_descriptor desc = {
+        .buf_size = len,
+        .width = FB_WIDTH,
+        .height = y2 - y1 + 1,
+        .pitch = FB_WIDTH,
+    };
+    int ret = display_write(fb->dev, 0, y1, &desc, &fb->out[offset]);
+    if (ret < 0) {
+        LOG_ERR("Failed to write rows %d-%d (%d)", y1, y2, ret);
+        return;
+    }
+
+#if IS_ENABLED(CONFIG_NICE_OLED_BOOT_TIMING)
+    boot_timing_flushed();
+#endif
+}
+
+void fb_flush(struct fb *fb) { fb_write_rows(fb, 0, FB_HEIGHT - 1); }
+
+void fb_patch_img(struct fb *fb, lv_coord_t x, lv_coord_t y, const lv_img_dsc_t *img) {
+    fb_blit_img(fb, x, y, img);
+
+    lv_point_t a = rotation_map(fb->angle, fb->pivot, x, y);
+    lv_point_t b = rotation_map(fb->angle, fb->pivot, x + img->header.w - 1,
+                                y + img->header.h - 1);
+    fb_write_rows(fb, MIN(a.y, b.y), MAX(a.y, b.y));
+}
+
+/** ───── Sprites ────────────────────────────────────────── */
+
+static void fb_sprite_rows(const struct fb_sprite *sprite, lv_coord_t *y1, lv_coord_t *y2) {
+    if (sprite->frames == NULL) {
+        return;
+    }
+    *y1 = MIN(*y1, sprite->y);
+    *y2 = MAX(*y2, sprite->y + (lv_coord_t)sprite->frames[sprite->index]->header.h - 1);
+}
+
+static void fb_sprite_step(struct k_work *work) {
+    struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+    struct fb_sprite *sprite = CONTAINER_OF(dwork, struct fb_sprite, work);
+    lv_coord_t y1 = LV_COORD_MAX;
+    lv_coord_t y2 = LV_COORD_MIN;
+
+    if (!sprite->used || sprite->frames == NULL) {
+        return;
+    }
+
+    fb_sprite_rows(sprite, &y1, &y2);
+    sprite->index = (sprite->index + 1) % sprite->count;
+    fb_sprite_rows(sprite, &y1, &y2);
+    fb_write_rows(&fb_state, y1, y2);
+
+    k_work_reschedule_for_queue(zmk_display_work_q(), &sprite->work, K_MSEC(sprite->frame_ms));
+}
+
+struct fb_sprite *fb_sprite_get(void) {
+    for (int i = 0; i < ARRAY_SIZE(fb_state.sprites); i++) {
+        struct fb_sprite *sprite = &fb_state.sprites[i];
+        if (!sprite->used) {
+            sprite->used = true;
+            sprite->frames = NULL;
+            sprite->x = 0;
+            sprite->y = 0;
+            return sprite;
+        }
+    }
+
+    LOG_WRN("Out of sprites, raise CONFIG_NICE_OLED_ENGINE_SPRITES");
+    return NULL;
+}
+
+void fb_sprite_hide(struct fb_sprite *sprite) {
+    lv_coord_t y1 = LV_COORD_MAX;
+    lv_coord_t y2 = LV_COORD_MIN;
+
+    if (sprite == NULL || sprite->frames == NULL) {
+        return;
+    }
+
+    k_work_cancel_delayable(&sprite->work);
+    fb_sprite_rows(sprite, &y1, &y2);
+    sprite->frames = NULL;
+    fb_write_rows(&fb_state, y1, y2);
+}
+
+void fb_sprite_put(struct fb_sprite *sprite) {
+    if (sprite == NULL) {
+        return;
+    }
+
+    fb_sprite_hide(sprite);
+    sprite->used = false;
+}
+
+void fb_sprite_play(struct fb_sprite *sprite, const lv_img_dsc_t *const *frames, uint8_t count,
+                    uint32_t duration_ms) {
+    lv_coord_t y1 = LV_COORD_MAX;
+    lv_coord_t y2 = LV_COORD_MIN;
+
+    if (sprite == NULL || count == 0) {
+        return;
+    }
+    for (int i = 0; i < count; i++) {
+        if (!img_supported(frames[i])) {
+            return;
+        }
+    }
+
+    fb_sprite_rows(sprite, &y1, &y2);
+    sprite->frames = frames;
+    sprite->count = count;
+    sprite->index = 0;
+    sprite->frame_ms = count > 1 ? duration_ms / count : 0;
+    fb_sprite_rows(sprite, &y1, &y2);
+    fb_write_rows(&fb_state, y1, y2);
+
+    if (sprite->frame_ms > 0) {
+        k_work_reschedule_for_queue(zmk_display_work_q(), &sprite->work,
+                                    K_MSEC(sprite->frame_ms));
+    } else {
+        k_work_cancel_delayable(&sprite->work);
+    }
+}
+
+void fb_sprite_show(struct fb_sprite *sprite, const lv_img_dsc_t *img) {
+    if (sprite == NULL) {
+        return;
+    }
+
+    sprite->still = img;
+    fb_sprite_play(sprite, &sprite->still, 1, 0);
+}
+
+void fb_sprite_set_pos(struct fb_sprite *sprite, lv_coord_t x, lv_coord_t y) {
+    lv_coord_t y1 = LV_COORD_MAX;
+    lv_coord_t y2 = LV_COORD_MIN;
+
+    if (sprite == NULL) {
+        return;
+    }
+
+    fb_sprite_rows(sprite, &y1, &y2);
+    sprite->x = x;
+    sprite->y = y;
+    fb_sprite_rows(sprite, &y1, &y2);
+    fb_write_rows(&fb_state, y1, y2);
+}
+
+/** ───── Init ───────────────────────────────────────────── */
+
+int fb_init(void) {
+    struct fb *fb = &fb_state;
+    struct display_capabilities caps;
+
+    fb->dev = DEVICE_DT_GET(FB_NODE);
+    if (!device_is_ready(fb->dev)) {
+        LOG_ERR("Display device not ready");
+        return -ENODEV;
+    }
+
+    display_get_capabilities(fb->dev, &caps);
+    fb->vtiled = caps.screen_info & SCREEN_INFO_MONO_VTILED;
+    fb->msb_first = caps.screen_info & SCREEN_INFO_MONO_MSB_FIRST;
+    fb->invert = caps.current_pixel_format == PIXEL_FORMAT_MONO10;
+    fb->angle = panel_software_rotation();
+    fb->pivot = rotation_pivot(fb->angle);
+
+    for (int i = 0; i < ARRAY_SIZE(fb->sprites); i++) {
+        k_work_init_delayable(&fb->sprites[i].work, fb_sprite_step);
+    }
+
+    // ZMK still runs LVGL for its screen object, but it never draws again
+    lv_disp_t *disp = lv_disp_get_default();
+    if (disp != NULL && disp->refr_timer != NULL) {
+        lv_timer_pause(disp->refr_timer);
+    }
+
+    fb_clear(fb);
+    return 0;
+}
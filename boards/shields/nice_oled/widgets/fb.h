@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <lvgl.h>
+#include <stdint.h>
+
+/*
+ * Minimal 1bpp rendering engine that bypasses LVGL's canvas, image decoder
+ * and animation timers. Widgets draw into a scene framebuffer in the same
+ * portrait coordinates they use on the canvas; the engine maps them to the
+ * panel orientation as it goes. Sprites are composed on top of the scene in
+ * panel coordinates, like the pre-rotated LVGL animations they replace, and
+ * the result is written with display_write().
+ *
+ * Only the data formats of LVGL are used: lv_img_dsc_t (indexed 1 and 2 bit)
+ * and 1bpp lv_font_t fonts the mono_text fast path understands.
+ */
+
+struct fb;
+struct fb_sprite;
+
+int fb_init(void);
+struct fb *fb_get(void);
+
+// Scene drawing, in logical (portrait) coordinates
+void fb_clear(struct fb *fb);
+void fb_fill_rect(struct fb *fb, lv_coord_t x, lv_coord_t y, lv_coord_t w, lv_coord_t h,
+                  lv_color_t color);
+void fb_line(struct fb *fb, const lv_point_t points[], uint32_t count, lv_coord_t width,
+             lv_color_t color);
+void fb_blit_img(struct fb *fb, lv_coord_t x, lv_coord_t y, const lv_img_dsc_t *img);
+void fb_text(struct fb *fb, lv_coord_t x, lv_coord_t y, lv_coord_t max_w, const lv_font_t *font,
+             lv_color_t color, const char *txt);
+
+// Compose the scene and sprites and write the whole frame to the panel.
+void fb_flush(struct fb *fb);
+
+// Draw an opaque image into the scene and write only the rows it covers.
+void fb_patch_img(struct fb *fb, lv_coord_t x, lv_coord_t y, const lv_img_dsc_t *img);
+
+/*
+ * Sprite player. A sprite cycles through `count` frames once per
+ * `duration_ms` in panel coordinates; a single frame or a zero duration shows
+ * a still image. Only the rows a sprite covers are rewritten when it steps.
+ */
+struct fb_sprite *fb_sprite_get(void);
+void fb_sprite_put(struct fb_sprite *sprite);
+void fb_sprite_play(struct fb_sprite *sprite, const lv_img_dsc_t *const *frames, uint8_t count,
+                    uint32_t duration_ms);
+void fb_sprite_show(struct fb_sprite *sprite, const lv_img_dsc_t *img);
+void fb_sprite_hide(struct fb_sprite *sprite);
+void fb_sprite_set_pos(struct fb_sprite *sprite, lv_coord_t x, lv_coord_t y);
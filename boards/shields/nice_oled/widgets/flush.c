@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <errno.h>
+#include <zephyr/kernel.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include "flush.h"
+
+#if IS_ENABLED(CONFIG_NICE_OLED_BUS_GOVERNOR)
+#include "bus_governor.h"
+#endif
+
+#if IS_ENABLED(CONFIG_NICE_OLED_FRAME_DEDUP)
+#include "frame_dedup.h"
+#endif
+
+#if IS_ENABLED(CONFIG_NICE_OLED_BOOT_TIMING)
+#include "boot_timing.h"
+#endif
+
+static void (*display_flush_cb)(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p);
+
+static void flush_hook_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p) {
+#if IS_ENABLED(CONFIG_NICE_OLED_FRAME_DEDUP)
+    if (frame_dedup_unchanged(area, (const uint8_t *)color_p, flush_area_bytes(area))) {
+        lv_disp_flush_ready(drv);
+        return;
+    }
+#endif
+
+    display_flush_cb(drv, area, color_p);
+
+#if IS_ENABLED(CONFIG_NICE_OLED_BUS_GOVERNOR)
+    bus_governor_account(flush_area_bytes(area));
+#endif
+
+#if IS_ENABLED(CONFIG_NICE_OLED_BOOT_TIMING)
+    // A frame can take several flushes, it is complete with the last one
+    if (lv_disp_flush_is_last(drv)) {
+        boot_timing_flushed();
+    }
+#endif
+}
+
+int flush_hook_init(void) {
+    lv_disp_t *disp = lv_disp_get_default();
+    if (disp == NULL || disp->driver == NULL || disp->driver->flush_cb == NULL) {
+        return -ENODEV;
+    }
+
+    if (disp->driver->flush_cb != flush_hook_cb) {
+        display_flush_cb = disp->driver->flush_cb;
+        disp->driver->flush_cb = flush_hook_cb;
+    }
+
+    return 0;
+}
@@ -0,0 +1,24 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <lvgl.h>
+
+/*
+ * Sits between LVGL and the Zephyr display driver's flush callback so the
+ * shield can account for, and filter, what actually goes over the display bus.
+ */
+
+int flush_hook_init(void);
+
+// Number of bytes a flush of `area` puts on the bus.
+static inline size_t flush_area_bytes(const lv_area_t *area) {
+    return ((size_t)lv_area_get_width(area) * lv_area_get_height(area) *
+                CONFIG_LV_Z_BITS_PER_PIXEL +
+            7) /
+           8;
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <string.h>
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/display.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/crc.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <zmk/event_manager.h>
+#include <zmk/events/activity_state_changed.h>
+
+#include "frame_dedup.h"
+
+#define PANEL_NODE DT_CHOSEN(zephyr_display)
+#define PANEL_ROWS DT_PROP(PANEL_NODE, height)
+// Vertically tiled panels (SSD1306) take whole 8-row pages
+#define PAGE_ROWS 8
+
+struct span_hash {
+    lv_coord_t x1;
+    lv_coord_t x2;
+    uint32_t crc;
+    bool valid;
+};
+
+// One entry per page, or per line on line-addressed panels
+static struct span_hash spans[PANEL_ROWS];
+static uint8_t span_rows;
+static atomic_t stale;
+static uint32_t skipped;
+
+static uint8_t panel_span_rows(void) {
+    struct display_capabilities caps;
+    display_get_capabilities(DEVICE_DT_GET(PANEL_NODE), &caps);
+    return (caps.screen_info & SCREEN_INFO_MONO_VTILED) ? PAGE_ROWS : 1;
+}
+
+bool frame_dedup_unchanged(const lv_area_t *area, const uint8_t *buf, size_t len) {
+    lv_coord_t height = lv_area_get_height(area);
+
+    if (span_rows == 0) {
+        span_rows = panel_span_rows();
+    }
+
+    // The panel may have lost what it showed since the last flush
+    if (atomic_clear(&stale)) {
+        memset(spans, 0, sizeof(spans));
+    }
+
+    // Each span of the area is `len / spans` bytes whether the panel tiles
+    // vertically or horizontally, as long as the area is span aligned.
+    if (area->y1 < 0 || area->y1 % span_rows != 0 || height % span_rows != 0 ||
+        area->y2 / span_rows >= ARRAY_SIZE(spans)) {
+        memset(spans, 0, sizeof(spans));
+        return false;
+    }
+
+    size_t span_len = len / (height / span_rows);
+    bool unchanged = true;
+
+    for (int span = area->y1 / span_rows; span <= area->y2 / span_rows; span++) {
+        struct span_hash *hash = &spans[span];
+        uint32_t crc = crc32_ieee(buf, span_len);
+
+        if (!hash->valid || hash->x1 != area->x1 || hash->x2 != area->x2 || hash->crc != crc) {
+            unchanged = false;
+            *hash = (struct span_hash){.x1 = area->x1, .x2 = area->x2, .crc = crc, .valid = true};
+        }
+        buf += span_len;
+    }
+
+    if (unchanged) {
+        skipped++;
+        LOG_DBG("Skipped identical flush, %u so far", skipped);
+    }
+
+    return unchanged;
+}
+
+// Safe from any thread, the hashes are dropped by the next flush
+void frame_dedup_reset(void) { atomic_set(&stale, 1); }
+
+uint32_t frame_dedup_skipped(void) { return skipped; }
+
+// Blanked or asleep, the panel may come back cleared
+static int frame_dedup_activity_listener(const zmk_event_t *eh) {
+    frame_dedup_reset();
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+ZMK_LISTENER(nice_oled_frame_dedup, frame_dedup_activity_listener);
+ZMK_SUBSCRIPTION(nice_oled_frame_dedup, zmk_activity_state_changed);
@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <lvgl.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/sys/util.h>
+
+#if IS_ENABLED(CONFIG_NICE_OLED_FRAME_DEDUP)
+
+/*
+ * Remembers a CRC32 for every span last written to the panel: an 8-row page
+ * on vertically tiled panels like the SSD1306, a single line on line-addressed
+ * ones like the nice!view. A flush whose spans all hash the same as what the
+ * panel already shows is dropped.
+ */
+
+bool frame_dedup_unchanged(const lv_area_t *area, const uint8_t *buf, size_t len);
+
+// Forget what the panel shows, e.g. after blanking. Callable from any thread.
+void frame_dedup_reset(void);
+
+uint32_t frame_dedup_skipped(void);
+
+#else
+
+static inline void frame_dedup_reset(void) {}
+
+#endif
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+
+#include "label_cache.h"
+#include "mono_text.h"
+#include "util.h"
+
+// Sized for the 13 character labels the widgets draw
+#define LABEL_TEXT_LEN 14
+#define LABEL_MAX_W 112
+#define LABEL_MAX_H 16
+#define LABEL_STRIDE DIV_ROUND_UP(LABEL_MAX_W, 8)
+
+// Glyphs may overhang their advance; keep one extra cell of pixels
+#define LABEL_OVERHANG 8
+
+struct label_entry {
+    const lv_font_t *font;
+    char text[LABEL_TEXT_LEN];
+    lv_coord_t w;
+    lv_coord_t h;
+    uint32_t last_used;
+    uint8_t bits[LABEL_STRIDE * LABEL_MAX_H];
+};
+
+static struct label_entry entries[CONFIG_NICE_OLED_LABEL_CACHE_SIZE];
+static uint32_t use_clock;
+
+static struct label_entry *label_lookup(const lv_font_t *font, const char *txt, lv_coord_t width) {
+    struct label_entry *victim = &entries[0];
+
+    for (int i = 0; i < ARRAY_SIZE(entries); i++) {
+        struct label_entry *entry = &entries[i];
+        if (entry->font == font && strcmp(entry->text, txt) == 0) {
+            entry->last_used = ++use_clock;
+            return entry;
+        }
+        if (entry->font == NULL || entry->last_used < victim->last_used) {
+            victim = entry;
+        }
+    }
+
+    victim->font = font;
+    strcpy(victim->text, txt);
+    victim->w = width + LABEL_OVERHANG;
+    victim->h = font->line_height;
+    victim->last_used = ++use_clock;
+    mono_text_render(font, txt, victim->bits, LABEL_STRIDE, victim->w, victim->h);
+
+    return victim;
+}
+
+void canvas_draw_label(lv_obj_t *canvas, lv_coord_t x, lv_coord_t y, lv_coord_t max_w,
+                       const lv_draw_label_dsc_t *dsc, const char *txt) {
+    lv_coord_t width = mono_text_width(dsc->font, txt);
+
+    if (width < 0 || width > max_w || width + LABEL_OVERHANG > LABEL_MAX_W ||
+        strlen(txt) >= LABEL_TEXT_LEN || dsc->font->line_height > LABEL_MAX_H ||
+        lv_canvas_get_img(canvas)->header.cf != LV_IMG_CF_TRUE_COLOR ||
+        !mono_label_dsc_supported(dsc)) {
+        canvas_draw_mono_text(canvas, x, y, max_w, dsc, txt);
+        return;
+    }
+
+    const struct label_entry *entry = label_lookup(dsc->font, txt, width);
+    canvas_draw_bits(canvas, x, y, max_w, entry->bits, LABEL_STRIDE, entry->w, entry->h,
+                     dsc->color);
+}
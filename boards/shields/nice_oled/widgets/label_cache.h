@@ -0,0 +1,17 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <lvgl.h>
+
+/*
+ * Small LRU cache of rasterized labels keyed by (font, string). A label that
+ * was drawn before becomes one bitmap copy into the canvas. Labels the cache
+ * can't hold are drawn by canvas_draw_mono_text().
+ */
+void canvas_draw_label(lv_obj_t *canvas, lv_coord_t x, lv_coord_t y, lv_coord_t max_w,
+                       const lv_draw_label_dsc_t *dsc, const char *txt);
@@ -1,33 +1,63 @@
 #include "layer.h"
 #include "../assets/custom_fonts.h"
+#include "ticker.h"
 #include <ctype.h> // Para toupper()
 #include <zephyr/kernel.h>
 
 // MC: better implementation
-void draw_layer_status(lv_obj_t *canvas, const struct status_state *state) {
-  lv_draw_label_dsc_t label_dsc;
-  init_label_dsc(&label_dsc, LVGL_FOREGROUND, &pixel_operator_mono,
-                 LV_TEXT_ALIGN_LEFT);
-
-  char text[14] = {};
-  int result;
-
-  if (state->layer_label == NULL) {
-    result = snprintf(text, sizeof(text), "Layer %i", state->layer_index);
-  } else {
-    result = snprintf(text, sizeof(text), "%s", state->layer_label);
-    for (int i = 0; text[i] != '\0'; i++) {
-      // toupper( ... ): This function, found in the ctype.h library, takes a
-      // character as an argument and converts it to its uppercase equivalent.
-      // If the character is already uppercase or not a letter, the function
-      // returns it unchanged.
-      text[i] = toupper(text[i]);
+const char *layer_status_text(const struct status_state *state) {
+  // The label only changes with the layer, so keep the uppercased copy around
+  static char text[TICKER_TEXT_LEN] = {};
+  static const char *last_label;
+  static uint8_t last_index;
+  static bool valid;
+
+  if (!valid || state->layer_label != last_label ||
+      state->layer_index != last_index) {
+    int result;
+
+    if (state->layer_label == NULL) {
+      result = snprintf(text, sizeof(text), "Layer %i", state->layer_index);
+    } else {
+      result = snprintf(text, sizeof(text), "%s", state->layer_label);
+      for (int i = 0; text[i] != '\0'; i++) {
+        // toupper( ... ): This function, found in the ctype.h library, takes a
+        // character as an argument and converts it to its uppercase
+        // equivalent. If the character is already uppercase or not a letter,
+        // the function returns it unchanged.
+        text[i] = toupper(text[i]);
+      }
+    }
+
+    if (result >= sizeof(text)) {
+      LV_LOG_WARN("truncated");
     }
+
+    last_label = state->layer_label;
+    last_index = state->layer_index;
+    valid = true;
   }
 
-  if (result >= sizeof(text)) {
-    LV_LOG_WARN("truncated");
+  return text;
+}
+
+void draw_layer_status(draw_target_t *canvas, const lv_area_t *area,
+                       const struct draw_dscs *dscs,
+                       const struct status_state *state) {
+  const char *text = layer_status_text(state);
+
+#if IS_ENABLED(CONFIG_NICE_OLED_LAYER_TICKER)
+  // Names wider than the screen scroll by themselves between redraws
+  static struct ticker ticker;
+  const lv_img_dsc_t *img =
+      ticker_update(&ticker, canvas, area->x1, area->y1,
+                    lv_area_get_width(area), &dscs->label, text);
+  if (img != NULL) {
+    draw_img(canvas, area->x1, area->y1, img, &dscs->img);
+    return;
   }
+#endif
 
-  lv_canvas_draw_text(canvas, 0, 146, 68, &label_dsc, text);
+  draw_label(canvas, area->x1, area->y1, lv_area_get_width(area), &dscs->label,
+             text);
 }
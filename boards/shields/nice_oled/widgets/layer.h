@@ -8,4 +8,7 @@ struct layer_status_state {
     const char *label;
 };
 
-void draw_layer_status(lv_obj_t *canvas, const struct status_state *state);
\ No newline at end of file
+const char *layer_status_text(const struct status_state *state);
+void draw_layer_status(draw_target_t *canvas, const lv_area_t *area,
+                       const struct draw_dscs *dscs,
+                       const struct status_state *state);
\ No newline at end of file
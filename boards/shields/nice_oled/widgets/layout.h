@@ -0,0 +1,20 @@
+#pragma once
+
+#include <lvgl.h>
+
+/*
+ * Where each status element sits in the portrait CANVAS_WIDTH x CANVAS_HEIGHT
+ * drawing area. Elements draw relative to the top left corner of their box
+ * and stay inside it (pixels left of x = 0 are clipped anyway), so the box is
+ * also what has to be redrawn when the element changes.
+ */
+
+#define LAYOUT_AREA(x, y, w, h)                                                \
+  { .x1 = (x), .y1 = (y), .x2 = (x) + (w)-1, .y2 = (y) + (h)-1 }
+
+#define LAYOUT_OUTPUT LAYOUT_AREA(0, 32, 22, 15)
+#define LAYOUT_PROFILE_NUMBER LAYOUT_AREA(25, 32, 35, 7)
+#define LAYOUT_BATTERY LAYOUT_AREA(0, 50, 42, 18)
+#define LAYOUT_WPM LAYOUT_AREA(0, 64, 68, 65)
+#define LAYOUT_PROFILES LAYOUT_AREA(0, 137, 31, 3)
+#define LAYOUT_LAYER LAYOUT_AREA(0, 146, 68, 14)
@@ -5,21 +5,62 @@
  */
 
 #include <zephyr/kernel.h>
-#include <zephyr/bluetooth/services/bas.h>
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 
+#include <dt-bindings/zmk/modifiers.h>
 #include <zmk/display.h>
 #include <zmk/event_manager.h>
+#include <zmk/events/hid_indicators_changed.h>
+#include <zmk/events/position_state_changed.h>
 #include <zmk/events/wpm_state_changed.h>
+#include <zmk/hid.h>
+#include <zmk/hid_indicators.h>
 #include <zmk/wpm.h>
 
 #include "luna.h"
+#include "mods_changed.h"
 
-#define SRC(array) (const void **)array, sizeof(array) / sizeof(lv_img_dsc_t *)
+/*
+ * One Luna for WPM, modifiers and lock keys. Each input only updates its
+ * field of the widget's inputs; the animation is resolved from all of them by
+ * fixed priority (locks, then modifiers, then WPM) and the sprite is only
+ * touched when the resolved state changes, so switching straight from one
+ * override to another works too.
+ */
 
-static sys_slist_t widgets = SYS_SLIST_STATIC_INIT(&widgets);
+#define SRC(array) array, ARRAY_SIZE(array)
+
+#define LED_NLCK 0x01
+#define LED_CLCK 0x02
+#define LED_SLCK 0x04
+
+#if IS_ENABLED(CONFIG_NICE_OLED_WIDGET_HID_INDICATORS_LUNA_ONLY_CAPSLOCK)
+#define LUNA_LOCKS LED_CLCK
+#else
+#define LUNA_LOCKS (LED_CLCK | LED_NLCK | LED_SLCK)
+#endif
+
+#ifdef CONFIG_NICE_OLED_WIDGET_HID_INDICATORS_LUNA_ANIMATION_MS
+#define ANIMATION_SPEED_BARK CONFIG_NICE_OLED_WIDGET_HID_INDICATORS_LUNA_ANIMATION_MS
+#else
+#define ANIMATION_SPEED_BARK 300
+#endif
+
+#ifdef CONFIG_NICE_OLED_WIDGET_MODIFIERS_INDICATORS_LUNA_ANIMATION_MS
+#define ANIMATION_SPEED_MODS CONFIG_NICE_OLED_WIDGET_MODIFIERS_INDICATORS_LUNA_ANIMATION_MS
+#else
+#define ANIMATION_SPEED_MODS 300
+#endif
+
+// #define ANIMATION_SPEED_IDLE 10000
+#define ANIMATION_SPEED_IDLE 960
+// #define ANIMATION_SPEED_SLOW 2000
+#define ANIMATION_SPEED_SLOW 200
+// #define ANIMATION_SPEED_MID 500
+#define ANIMATION_SPEED_MID 200
+#define ANIMATION_SPEED_FAST 200
 
 LV_IMG_DECLARE(dog_sit1_90);
 LV_IMG_DECLARE(dog_sit2_90);
@@ -29,106 +70,307 @@ LV_IMG_DECLARE(dog_run1_90);
 LV_IMG_DECLARE(dog_run2_90);
 LV_IMG_DECLARE(dog_sneak1_90);
 LV_IMG_DECLARE(dog_sneak2_90);
+LV_IMG_DECLARE(dog_bark1_90);
+LV_IMG_DECLARE(dog_bark2_90);
 
-// #define ANIMATION_SPEED_IDLE 10000
-#define ANIMATION_SPEED_IDLE 960
-const lv_img_dsc_t *idle_imgs[] = {
-    &dog_sit1_90,
-    &dog_sit2_90,
-};
+static const lv_img_dsc_t *const sit_imgs[] = {&dog_sit1_90, &dog_sit2_90};
+static const lv_img_dsc_t *const walk_imgs[] = {&dog_walk1_90, &dog_walk2_90};
+static const lv_img_dsc_t *const run_imgs[] = {&dog_run1_90, &dog_run2_90};
+static const lv_img_dsc_t *const sneak_imgs[] = {&dog_sneak1_90, &dog_sneak2_90};
+static const lv_img_dsc_t *const bark_imgs[] = {&dog_bark1_90, &dog_bark2_90};
 
-// #define ANIMATION_SPEED_SLOW 2000
-#define ANIMATION_SPEED_SLOW 200
-const lv_img_dsc_t *slow_imgs[] = {
-    &dog_walk1_90,
-    &dog_walk2_90,
+struct luna_anim {
+    const lv_img_dsc_t *const *frames;
+    uint8_t count;
+    uint32_t duration_ms;
 };
 
-// #define ANIMATION_SPEED_MID 500
-#define ANIMATION_SPEED_MID 200
-const lv_img_dsc_t *mid_imgs[] = {
-    &dog_walk1_90,
-    &dog_walk2_90,
+static const struct luna_anim luna_anims[] = {
+    [LUNA_IDLE] = {SRC(sit_imgs), ANIMATION_SPEED_IDLE},
+    [LUNA_SLOW] = {SRC(walk_imgs), ANIMATION_SPEED_SLOW},
+    [LUNA_MID] = {SRC(walk_imgs), ANIMATION_SPEED_MID},
+    [LUNA_FAST] = {SRC(run_imgs), ANIMATION_SPEED_FAST},
+    [LUNA_SIT] = {SRC(sit_imgs), ANIMATION_SPEED_MODS},
+    [LUNA_WALK] = {SRC(walk_imgs), ANIMATION_SPEED_MODS},
+    [LUNA_RUN] = {SRC(run_imgs), ANIMATION_SPEED_MODS},
+    [LUNA_SNEAK] = {SRC(sneak_imgs), ANIMATION_SPEED_MODS},
+    [LUNA_BARK] = {SRC(bark_imgs), ANIMATION_SPEED_BARK},
 };
 
-#define ANIMATION_SPEED_FAST 200
-const lv_img_dsc_t *fast_imgs[] = {
-    &dog_run1_90,
-    &dog_run2_90,
+// First match wins
+static const struct {
+    uint8_t mods;
+    enum luna_state state;
+} luna_mod_states[] = {
+    {MOD_LGUI | MOD_RGUI, LUNA_SIT},
+    {MOD_LALT | MOD_RALT, LUNA_WALK},
+    {MOD_LCTL | MOD_RCTL, LUNA_RUN},
+    {MOD_LSFT | MOD_RSFT, LUNA_SNEAK},
 };
 
-struct luna_wpm_status_state {
-    uint8_t wpm;
+// Upper WPM bound of each state (idle def: 5)
+static const struct {
+    uint16_t below;
+    enum luna_state state;
+} luna_wpm_states[] = {
+    {15, LUNA_IDLE},
+    {30, LUNA_SLOW},
+    {70, LUNA_MID},
+    {UINT16_MAX, LUNA_FAST},
 };
 
-enum anim_state {
-    anim_state_none,
-    anim_state_idle,
-    anim_state_slow,
-    anim_state_mid,
-    anim_state_fast
-} current_anim_state;
-
-static void set_animation(lv_obj_t *animing, struct luna_wpm_status_state state) {
-    if (state.wpm < 15) { // def: 5
-        if (current_anim_state != anim_state_idle) {
-            lv_animimg_set_src(animing, SRC(idle_imgs));
-            lv_animimg_set_duration(animing, ANIMATION_SPEED_IDLE);
-            lv_animimg_set_repeat_count(animing, LV_ANIM_REPEAT_INFINITE);
-            lv_animimg_start(animing);
-            current_anim_state = anim_state_idle;
+static sys_slist_t widgets = SYS_SLIST_STATIC_INIT(&widgets);
+
+// The typing states, where per-key mode steps the frames by hand
+static bool luna_typing(enum luna_state state) {
+    return state >= LUNA_IDLE && state <= LUNA_FAST;
+}
+
+static enum luna_state luna_resolve(const struct luna_inputs *inputs) {
+    if (IS_ENABLED(CONFIG_NICE_OLED_WIDGET_HID_INDICATORS_LUNA) && (inputs->locks & LUNA_LOCKS)) {
+        return LUNA_BARK;
+    }
+
+    if (IS_ENABLED(CONFIG_NICE_OLED_WIDGET_MODIFIERS_INDICATORS_LUNA)) {
+        for (int i = 0; i < ARRAY_SIZE(luna_mod_states); i++) {
+            if (inputs->mods & luna_mod_states[i].mods) {
+                return luna_mod_states[i].state;
+            }
         }
-    } else if (state.wpm < 30) {
-        if (current_anim_state != anim_state_slow) {
-            lv_animimg_set_src(animing, SRC(slow_imgs));
-            lv_animimg_set_duration(animing, ANIMATION_SPEED_SLOW);
-            lv_animimg_set_repeat_count(animing, LV_ANIM_REPEAT_INFINITE);
-            lv_animimg_start(animing);
-            current_anim_state = anim_state_slow;
+    }
+
+    if (IS_ENABLED(CONFIG_NICE_OLED_WIDGET_WPM_LUNA)) {
+        for (int i = 0; i < ARRAY_SIZE(luna_wpm_states); i++) {
+            if (inputs->wpm < luna_wpm_states[i].below) {
+                return luna_wpm_states[i].state;
+            }
         }
-    } else if (state.wpm < 70) {
-        if (current_anim_state != anim_state_mid) {
-            lv_animimg_set_src(animing, SRC(mid_imgs));
-            lv_animimg_set_duration(animing, ANIMATION_SPEED_MID);
-            lv_animimg_set_repeat_count(animing, LV_ANIM_REPEAT_INFINITE);
-            lv_animimg_start(animing);
-            current_anim_state = anim_state_mid;
+    }
+
+    return LUNA_NONE;
+}
+
+static void luna_release(struct k_work *work) {
+    struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+    struct zmk_widget_luna *widget = CONTAINER_OF(dwork, struct zmk_widget_luna, release_work);
+
+    if (widget->state != LUNA_NONE || widget->obj == NULL) {
+        return;
+    }
+
+    LOG_DBG("Luna idle, releasing its sprite");
+    sprite_delete(widget->obj);
+    widget->obj = NULL;
+    sprite_trim();
+}
+
+static void luna_update(struct zmk_widget_luna *widget) {
+    enum luna_state state = luna_resolve(&widget->inputs);
+    if (state == widget->state) {
+        return;
+    }
+
+    // Only take the new state once there is a sprite for it, so the next
+    // update tries again when none was free
+    if (state != LUNA_NONE && widget->obj == NULL) {
+        static bool warned;
+
+        widget->obj = sprite_create(widget->parent);
+        if (widget->obj == NULL) {
+            if (!warned) {
+                LOG_WRN("No sprite for Luna, it stays hidden until one is free");
+                warned = true;
+            }
+            return;
         }
-    } else {
-        if (current_anim_state != anim_state_fast) {
-            lv_animimg_set_src(animing, SRC(fast_imgs));
-            lv_animimg_set_duration(animing, ANIMATION_SPEED_FAST);
-            lv_animimg_set_repeat_count(animing, LV_ANIM_REPEAT_INFINITE);
-            lv_animimg_start(animing);
-            current_anim_state = anim_state_fast;
+        sprite_set_pos(widget->obj, widget->x, widget->y);
+    }
+
+    widget->state = state;
+    if (state == LUNA_NONE) {
+        sprite_hide(widget->obj);
+        if (CONFIG_NICE_OLED_LUNA_RELEASE_MS > 0) {
+            k_work_reschedule_for_queue(zmk_display_work_q(), &widget->release_work,
+                                        K_MSEC(CONFIG_NICE_OLED_LUNA_RELEASE_MS));
         }
+        return;
     }
+
+    k_work_cancel_delayable(&widget->release_work);
+
+    const struct luna_anim *anim = &luna_anims[state];
+    if (IS_ENABLED(CONFIG_NICE_OLED_LUNA_PER_KEY) && luna_typing(state)) {
+        // Still until the next key press
+        sprite_show(widget->obj, anim->frames[widget->frame % anim->count]);
+        return;
+    }
+    sprite_play(widget->obj, anim->frames, anim->count, anim->duration_ms,
+                BUS_PRIORITY_CHARACTER);
+}
+
+/** ───── Per key ────────────────────────────────────────── */
+#if IS_ENABLED(CONFIG_NICE_OLED_LUNA_PER_KEY)
+// Presses waiting for a frame; more than this during a burst are dropped
+#define LUNA_KEY_QUEUE 4
+
+static atomic_t luna_keys;
+// Uptime in ms of the last step, read by the listener on the event thread
+static atomic_t luna_key_last;
+
+// One frame per run, at most one run per display refresh
+static void luna_key_step(struct k_work *work) {
+    struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+
+    if (atomic_dec(&luna_keys) <= 0) {
+        atomic_clear(&luna_keys);
+        return;
+    }
+    atomic_set(&luna_key_last, k_uptime_get_32());
+
+    struct zmk_widget_luna *widget;
+    SYS_SLIST_FOR_EACH_CONTAINER(&widgets, widget, node) {
+        widget->frame++;
+        if (widget->obj != NULL && luna_typing(widget->state)) {
+            const struct luna_anim *anim = &luna_anims[widget->state];
+            sprite_show(widget->obj, anim->frames[widget->frame % anim->count]);
+        }
+    }
+
+    if (atomic_get(&luna_keys) > 0) {
+        k_work_schedule_for_queue(zmk_display_work_q(), dwork, K_MSEC(LV_DISP_DEF_REFR_PERIOD));
+    }
+}
+
+static K_WORK_DELAYABLE_DEFINE(luna_key_work, luna_key_step);
+
+/*
+ * Runs in the event manager context on every key, so it only counts the press
+ * and makes sure the step is scheduled. Taps are never lost to the once a
+ * second WPM update, and a burst costs at most LUNA_KEY_QUEUE frames.
+ */
+static int luna_key_listener(const zmk_event_t *eh) {
+    const struct zmk_position_state_changed *ev = as_zmk_position_state_changed(eh);
+    if (ev == NULL || !ev->state) {
+        return ZMK_EV_EVENT_BUBBLE;
+    }
+
+    atomic_val_t queued;
+    do {
+        queued = atomic_get(&luna_keys);
+        if (queued >= LUNA_KEY_QUEUE) {
+            return ZMK_EV_EVENT_BUBBLE;
+        }
+    } while (!atomic_cas(&luna_keys, queued, queued + 1));
+
+    // A refresh after the last step at the earliest; already scheduled work
+    // keeps its time
+    int32_t wait = (uint32_t)atomic_get(&luna_key_last) + LV_DISP_DEF_REFR_PERIOD -
+                   k_uptime_get_32();
+    k_work_schedule_for_queue(zmk_display_work_q(), &luna_key_work, K_MSEC(MAX(0, wait)));
+    return ZMK_EV_EVENT_BUBBLE;
 }
 
-struct luna_wpm_status_state luna_wpm_status_get_state(const zmk_event_t *eh) {
-    struct zmk_wpm_state_changed *ev = as_zmk_wpm_state_changed(eh);
-    return (struct luna_wpm_status_state){.wpm = ev->state};
+ZMK_LISTENER(widget_luna_keys, luna_key_listener);
+ZMK_SUBSCRIPTION(widget_luna_keys, zmk_position_state_changed);
+#endif
+
+/** ───── WPM ────────────────────────────────────────────── */
+#if IS_ENABLED(CONFIG_NICE_OLED_WIDGET_WPM_LUNA)
+struct luna_wpm_state {
+    uint8_t wpm;
 };
 
-void luna_wpm_status_update_cb(struct luna_wpm_status_state state) {
+static void luna_wpm_update_cb(struct luna_wpm_state state) {
     struct zmk_widget_luna *widget;
-    SYS_SLIST_FOR_EACH_CONTAINER(&widgets, widget, node) { set_animation(widget->obj, state); }
+    SYS_SLIST_FOR_EACH_CONTAINER(&widgets, widget, node) {
+        widget->inputs.wpm = state.wpm;
+        luna_update(widget);
+    }
 }
 
-ZMK_DISPLAY_WIDGET_LISTENER(widget_luna, struct luna_wpm_status_state, luna_wpm_status_update_cb,
-                            luna_wpm_status_get_state)
+static struct luna_wpm_state luna_wpm_get_state(const zmk_event_t *eh) {
+    const struct zmk_wpm_state_changed *ev = as_zmk_wpm_state_changed(eh);
+    return (struct luna_wpm_state){.wpm = ev ? ev->state : zmk_wpm_get_state()};
+}
+
+ZMK_DISPLAY_WIDGET_LISTENER(widget_luna_wpm, struct luna_wpm_state, luna_wpm_update_cb,
+                            luna_wpm_get_state)
+ZMK_SUBSCRIPTION(widget_luna_wpm, zmk_wpm_state_changed);
+#endif
+
+/** ───── Modifiers ──────────────────────────────────────── */
+#if IS_ENABLED(CONFIG_NICE_OLED_WIDGET_MODIFIERS_INDICATORS_LUNA)
+struct luna_mods_state {
+    uint8_t mods;
+};
+
+static void luna_mods_update_cb(struct luna_mods_state state) {
+    struct zmk_widget_luna *widget;
+    SYS_SLIST_FOR_EACH_CONTAINER(&widgets, widget, node) {
+        widget->inputs.mods = state.mods;
+        luna_update(widget);
+    }
+}
 
-ZMK_SUBSCRIPTION(widget_luna, zmk_wpm_state_changed);
+static struct luna_mods_state luna_mods_get_state(const zmk_event_t *eh) {
+    const struct nice_oled_mods_changed *ev = as_nice_oled_mods_changed(eh);
+    return (struct luna_mods_state){.mods = ev ? ev->mods : zmk_hid_get_explicit_mods()};
+}
 
-int zmk_widget_luna_init(struct zmk_widget_luna *widget, lv_obj_t *parent) {
-    widget->obj = lv_animimg_create(parent);
-    lv_obj_center(widget->obj);
+ZMK_DISPLAY_WIDGET_LISTENER(widget_luna_mods, struct luna_mods_state, luna_mods_update_cb,
+                            luna_mods_get_state)
+ZMK_SUBSCRIPTION(widget_luna_mods, nice_oled_mods_changed);
+#endif
+
+/** ───── Lock keys ──────────────────────────────────────── */
+#if IS_ENABLED(CONFIG_NICE_OLED_WIDGET_HID_INDICATORS_LUNA)
+struct luna_locks_state {
+    uint8_t locks;
+};
+
+static void luna_locks_update_cb(struct luna_locks_state state) {
+    struct zmk_widget_luna *widget;
+    SYS_SLIST_FOR_EACH_CONTAINER(&widgets, widget, node) {
+        widget->inputs.locks = state.locks;
+        luna_update(widget);
+    }
+}
+
+static struct luna_locks_state luna_locks_get_state(const zmk_event_t *eh) {
+    const struct zmk_hid_indicators_changed *ev = as_zmk_hid_indicators_changed(eh);
+    return (struct luna_locks_state){
+        .locks = ev ? ev->indicators : zmk_hid_indicators_get_current_profile(),
+    };
+}
+
+ZMK_DISPLAY_WIDGET_LISTENER(widget_luna_locks, struct luna_locks_state, luna_locks_update_cb,
+                            luna_locks_get_state)
+ZMK_SUBSCRIPTION(widget_luna_locks, zmk_hid_indicators_changed);
+#endif
+
+int zmk_widget_luna_init(struct zmk_widget_luna *widget, lv_obj_t *parent, lv_coord_t x,
+                         lv_coord_t y) {
+    // Created by the first state that shows something
+    widget->obj = NULL;
+    widget->parent = parent;
+    widget->x = x;
+    widget->y = y;
+    widget->state = LUNA_NONE;
+    widget->inputs = (struct luna_inputs){0};
+    widget->frame = 0;
+    k_work_init_delayable(&widget->release_work, luna_release);
 
     sys_slist_append(&widgets, &widget->node);
 
-    widget_luna_init();
+#if IS_ENABLED(CONFIG_NICE_OLED_WIDGET_WPM_LUNA)
+    widget_luna_wpm_init();
+#endif
+#if IS_ENABLED(CONFIG_NICE_OLED_WIDGET_MODIFIERS_INDICATORS_LUNA)
+    widget_luna_mods_init();
+#endif
+#if IS_ENABLED(CONFIG_NICE_OLED_WIDGET_HID_INDICATORS_LUNA)
+    widget_luna_locks_init();
+#endif
 
     return 0;
 }
-
-lv_obj_t *zmk_widget_luna_obj(struct zmk_widget_luna *widget) { return widget->obj; }
@@ -9,10 +9,47 @@
 #include <lvgl.h>
 #include <zephyr/kernel.h>
 
+#include "draw.h"
+
+enum luna_state {
+    LUNA_NONE,
+    // Typing speed
+    LUNA_IDLE,
+    LUNA_SLOW,
+    LUNA_MID,
+    LUNA_FAST,
+    // Modifiers held: GUI, Alt, Ctrl, Shift
+    LUNA_SIT,
+    LUNA_WALK,
+    LUNA_RUN,
+    LUNA_SNEAK,
+    // Lock key on
+    LUNA_BARK,
+};
+
+struct luna_inputs {
+    uint8_t wpm;
+    uint8_t mods;
+    uint8_t locks;
+};
+
+/*
+ * The sprite only exists while Luna has something to show: it is taken from
+ * the backend on the first state other than LUNA_NONE and handed back after
+ * CONFIG_NICE_OLED_LUNA_RELEASE_MS in LUNA_NONE.
+ */
 struct zmk_widget_luna {
     sys_snode_t node;
-    lv_obj_t *obj;
+    sprite_t *obj;
+    lv_obj_t *parent;
+    lv_coord_t x;
+    lv_coord_t y;
+    struct k_work_delayable release_work;
+    struct luna_inputs inputs;
+    enum luna_state state;
+    // Key presses seen, the frame shown in per-key mode
+    uint8_t frame;
 };
 
-int zmk_widget_luna_init(struct zmk_widget_luna *widget, lv_obj_t *parent);
-lv_obj_t *zmk_widget_luna_obj(struct zmk_widget_luna *widget);
+int zmk_widget_luna_init(struct zmk_widget_luna *widget, lv_obj_t *parent, lv_coord_t x,
+                         lv_coord_t y);
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <lvgl.h>
+#include <zephyr/kernel.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <zmk/activity.h>
+#include <zmk/display.h>
+#include <zmk/event_manager.h>
+#include <zmk/events/activity_state_changed.h>
+
+#include "lvgl_service.h"
+
+#define STATS_LOG_MS 60000
+
+static void lvgl_service_run(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(service_work, lvgl_service_run);
+
+static bool initialized;
+static uint32_t start_ms;
+static uint32_t wakeups;
+static uint32_t logged_ms;
+
+// ZMK's display tick keeps running whenever the display is not blanked
+static bool ticking;
+static uint32_t ticking_since;
+static uint32_t ticked_ms;
+
+static uint32_t zmk_ticks(uint32_t now) {
+    uint32_t ms = ticked_ms + (ticking ? now - ticking_since : 0);
+    return ms / CONFIG_ZMK_DISPLAY_TICK_PERIOD_MS;
+}
+
+static void set_ticking(bool on) {
+    uint32_t now = k_uptime_get_32();
+
+    if (ticking && !on) {
+        ticked_ms += now - ticking_since;
+    } else if (!ticking && on) {
+        ticking_since = now;
+    }
+    ticking = on;
+}
+
+uint32_t lvgl_service_wakeups_per_sec_x100(void) {
+    uint32_t now = k_uptime_get_32();
+    uint32_t elapsed = now - start_ms;
+    uint64_t total = (uint64_t)wakeups + zmk_ticks(now);
+    return elapsed ? (uint32_t)(total * 100000 / elapsed) : 0;
+}
+
+// ZMK stops its display tick while the display is blanked, so do we
+static bool lvgl_service_blanked(void) {
+    return IS_ENABLED(CONFIG_ZMK_DISPLAY_BLANK_ON_IDLE) &&
+           zmk_activity_get_state() != ZMK_ACTIVITY_ACTIVE;
+}
+
+static void lvgl_service_run(struct k_work *work) {
+    if (lvgl_service_blanked()) {
+        return;
+    }
+
+    wakeups++;
+    uint32_t next = lv_timer_handler();
+
+    uint32_t now = k_uptime_get_32();
+    if (now - logged_ms >= STATS_LOG_MS) {
+        uint32_t rate = lvgl_service_wakeups_per_sec_x100();
+        LOG_DBG("LVGL service: %u.%02u wake-ups per second", rate / 100, rate % 100);
+        logged_ms = now;
+    }
+
+    // The refresh timer is periodic even with nothing to redraw; only
+    // invalidated areas and running animations need it
+    lv_disp_t *disp = lv_disp_get_default();
+    if (disp != NULL && disp->inv_p == 0 && lv_anim_count_running() == 0) {
+        return;
+    }
+
+    if (next == LV_NO_TIMER_READY) {
+        next = LV_DISP_DEF_REFR_PERIOD;
+    }
+    k_work_reschedule_for_queue(zmk_display_work_q(), &service_work, K_MSEC(MAX(next, 1)));
+}
+
+void lvgl_service_kick(void) {
+    if (!initialized) {
+        return;
+    }
+    k_work_reschedule_for_queue(zmk_display_work_q(), &service_work, K_NO_WAIT);
+}
+
+int lvgl_service_init(void) {
+    start_ms = k_uptime_get_32();
+    logged_ms = start_ms;
+    initialized = true;
+    set_ticking(!lvgl_service_blanked());
+
+    // The first frame is already waiting
+    lvgl_service_kick();
+    return 0;
+}
+
+static int lvgl_service_activity_listener(const zmk_event_t *eh) {
+    const struct zmk_activity_state_changed *ev = as_zmk_activity_state_changed(eh);
+    if (ev == NULL || !initialized) {
+        return ZMK_EV_EVENT_BUBBLE;
+    }
+
+    set_ticking(!IS_ENABLED(CONFIG_ZMK_DISPLAY_BLANK_ON_IDLE) || ev->state == ZMK_ACTIVITY_ACTIVE);
+    if (ev->state == ZMK_ACTIVITY_ACTIVE) {
+        // Whatever changed while blanked is drawn right away
+        lvgl_service_kick();
+    }
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+ZMK_LISTENER(lvgl_service, lvgl_service_activity_listener);
+ZMK_SUBSCRIPTION(lvgl_service, zmk_activity_state_changed);
@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <zephyr/sys/util.h>
+
+/*
+ * Runs LVGL's timer handler only when there is something to do. After each
+ * run it sleeps until the deadline LVGL reports, or, with nothing invalidated
+ * and no animation running, until the next lvgl_service_kick(). ZMK's fixed
+ * display tick is stretched to a slow fallback.
+ */
+
+#if IS_ENABLED(CONFIG_NICE_OLED_TICKLESS)
+
+int lvgl_service_init(void);
+
+// Something changed on screen: service LVGL once the current work item ends.
+void lvgl_service_kick(void);
+
+// Average wake-ups per second since init, in hundredths, ZMK's display tick included.
+uint32_t lvgl_service_wakeups_per_sec_x100(void);
+
+#else
+
+// ZMK's display tick services LVGL
+static inline void lvgl_service_kick(void) {}
+
+#endif
@@ -0,0 +1,26 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <zmk/event_manager.h>
+
+/*
+ * Raised when the explicit modifiers (MOD_LCTL ... MOD_RGUI) change. Widgets
+ * that only care about modifiers subscribe to this instead of
+ * zmk_keycode_state_changed, so ordinary key presses never reach the
+ * display work queue.
+ */
+
+struct nice_oled_mods_changed {
+    uint8_t mods;
+};
+
+ZMK_EVENT_DECLARE(nice_oled_mods_changed);
+
+// Last published modifiers, for widgets reading the state without an event
+uint8_t nice_oled_mods_get(void);
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+
+#include "mono_text.h"
+
+static const lv_font_fmt_txt_dsc_t *mono_font_dsc(const lv_font_t *font) {
+    return (const lv_font_fmt_txt_dsc_t *)font->dsc;
+}
+
+bool mono_font_supported(const lv_font_t *font) {
+    if (font == NULL || font->get_glyph_dsc != lv_font_get_glyph_dsc_fmt_txt) {
+        return false;
+    }
+
+    const lv_font_fmt_txt_dsc_t *fdsc = mono_font_dsc(font);
+    return fdsc->bpp == 1 && fdsc->bitmap_format == LV_FONT_FMT_TXT_PLAIN &&
+           fdsc->kern_dsc == NULL && fdsc->cmap_num == 1 &&
+           fdsc->cmaps[0].type == LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY;
+}
+
+static const lv_font_fmt_txt_glyph_dsc_t *mono_glyph(const lv_font_fmt_txt_dsc_t *fdsc, char c) {
+    const lv_font_fmt_txt_cmap_t *cmap = &fdsc->cmaps[0];
+    uint32_t ofs = (uint8_t)c - cmap->range_start;
+
+    if ((uint8_t)c < cmap->range_start || ofs >= cmap->range_length) {
+        return NULL;
+    }
+    return &fdsc->glyph_dsc[cmap->glyph_id_start + ofs];
+}
+
+// Same rounding as lv_font_get_glyph_dsc_fmt_txt(): adv_w is in 1/16 px
+static inline lv_coord_t mono_advance(const lv_font_fmt_txt_glyph_dsc_t *glyph) {
+    return (glyph->adv_w + (1 << 3)) >> 4;
+}
+
+lv_coord_t mono_text_width(const lv_font_t *font, const char *txt) {
+    if (!mono_font_supported(font)) {
+        return -1;
+    }
+
+    const lv_font_fmt_txt_dsc_t *fdsc = mono_font_dsc(font);
+    lv_coord_t width = 0;
+
+    for (const char *c = txt; *c != '\0'; c++) {
+        const lv_font_fmt_txt_glyph_dsc_t *glyph = mono_glyph(fdsc, *c);
+        if (glyph == NULL) {
+            return -1;
+        }
+        width += mono_advance(glyph);
+    }
+
+    return width;
+}
+
+bool mono_label_dsc_supported(const lv_draw_label_dsc_t *dsc) {
+    return (dsc->align == LV_TEXT_ALIGN_LEFT || dsc->align == LV_TEXT_ALIGN_AUTO) &&
+           dsc->letter_space == 0 && dsc->opa >= LV_OPA_MAX && dsc->ofs_x == 0 &&
+           dsc->ofs_y == 0 && dsc->flag == LV_TEXT_FLAG_NONE &&
+           dsc->decor == LV_TEXT_DECOR_NONE && dsc->blend_mode == LV_BLEND_MODE_NORMAL &&
+           dsc->sel_start == LV_DRAW_LABEL_NO_TXT_SEL;
+}
+
+// Called for every set glyph pixel inside the clip area
+typedef void (*mono_pixel_fn)(void *ctx, lv_coord_t x, lv_coord_t y);
+
+/*
+ * The one glyph walk both outputs share: glyphs at their fixed advance from
+ * (x, y), placed against the baseline the way lv_draw_label() does, clipped to
+ * `clip`. `txt` must be drawable by the fast path.
+ */
+static void mono_rasterize(const lv_font_t *font, const char *txt, lv_coord_t x, lv_coord_t y,
+                           const lv_area_t *clip, mono_pixel_fn pixel, void *ctx) {
+    const lv_font_fmt_txt_dsc_t *fdsc = mono_font_dsc(font);
+    lv_coord_t baseline = y + font->line_height - font->base_line;
+
+    for (const char *c = txt; *c != '\0'; c++) {
+        const lv_font_fmt_txt_glyph_dsc_t *glyph = mono_glyph(fdsc, *c);
+        const uint8_t *bitmap = &fdsc->glyph_bitmap[glyph->bitmap_index];
+        lv_coord_t gx = x + glyph->ofs_x;
+        lv_coord_t gy = baseline - glyph->box_h - glyph->ofs_y;
+        uint32_t bit = 0;
+
+        // 1bpp plain glyphs are packed MSB first with no padding between rows
+        for (int row = 0; row < glyph->box_h; row++) {
+            lv_coord_t py = gy + row;
+            for (int col = 0; col < glyph->box_w; col++, bit++) {
+                lv_coord_t px = gx + col;
+                if (!(bitmap[bit >> 3] & (0x80 >> (bit & 7)))) {
+                    continue;
+                }
+                if (px < clip->x1 || px > clip->x2 || py < clip->y1 || py > clip->y2) {
+                    continue;
+                }
+                pixel(ctx, px, py);
+            }
+        }
+
+        x += mono_advance(glyph);
+    }
+}
+
+struct mono_canvas_sink {
+    lv_color_t *cbuf;
+    lv_coord_t stride;
+    lv_color_t color;
+};
+
+static void mono_canvas_pixel(void *ctx, lv_coord_t x, lv_coord_t y) {
+    struct mono_canvas_sink *sink = ctx;
+    sink->cbuf[y * sink->stride + x] = sink->color;
+}
+
+struct mono_bits_sink {
+    uint8_t *bits;
+    lv_coord_t stride;
+};
+
+static void mono_bits_pixel(void *ctx, lv_coord_t x, lv_coord_t y) {
+    struct mono_bits_sink *sink = ctx;
+    sink->bits[y * sink->stride + (x >> 3)] |= 0x80 >> (x & 7);
+}
+
+void canvas_draw_mono_text(lv_obj_t *canvas, lv_coord_t x, lv_coord_t y, lv_coord_t max_w,
+                           const lv_draw_label_dsc_t *dsc, const char *txt) {
+    lv_img_dsc_t *img = lv_canvas_get_img(canvas);
+    lv_coord_t width = mono_text_width(dsc->font, txt);
+
+    // Text wider than max_w wraps in LVGL, leave that to LVGL
+    if (width < 0 || width > max_w || img->header.cf != LV_IMG_CF_TRUE_COLOR ||
+        !mono_label_dsc_supported(dsc)) {
+        lv_canvas_draw_text(canvas, x, y, max_w, dsc, txt);
+        return;
+    }
+
+    // Same clip area lv_canvas_draw_text() gives lv_draw_label()
+    lv_area_t clip = {MAX(x, 0), MAX(y, 0), MIN(x + max_w - 1, (lv_coord_t)img->header.w - 1),
+                      (lv_coord_t)img->header.h - 1};
+    struct mono_canvas_sink sink = {
+        .cbuf = (lv_color_t *)img->data,
+        .stride = img->header.w,
+        .color = dsc->color,
+    };
+    mono_rasterize(dsc->font, txt, x, y, &clip, mono_canvas_pixel, &sink);
+
+    // Only the line itself, so a partial redraw stays partial
+    lv_area_t area = {clip.x1, clip.y1, clip.x2, MIN(y + dsc->font->line_height - 1, clip.y2)};
+    if (area.x1 <= area.x2 && area.y1 <= area.y2) {
+        lv_obj_invalidate_area(canvas, &area);
+    }
+}
+
+void mono_text_render(const lv_font_t *font, const char *txt, uint8_t *bits, lv_coord_t stride,
+                      lv_coord_t w, lv_coord_t h) {
+    lv_area_t clip = {0, 0, w - 1, h - 1};
+    struct mono_bits_sink sink = {.bits = bits, .stride = stride};
+
+    memset(bits, 0, stride * h);
+    mono_rasterize(font, txt, 0, 0, &clip, mono_bits_pixel, &sink);
+}
@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <lvgl.h>
+#include <stdbool.h>
+
+/*
+ * Drop-in replacement for lv_canvas_draw_text() for the 1bpp PixelOperatorMono
+ * fonts. Glyphs are indexed directly from the code point and blitted at their
+ * fixed advance into the canvas buffer, producing the same pixels as LVGL.
+ * Anything the fast path does not cover (other fonts, alignment, wrapping,
+ * characters outside the font's range) goes through lv_canvas_draw_text().
+ */
+void canvas_draw_mono_text(lv_obj_t *canvas, lv_coord_t x, lv_coord_t y, lv_coord_t max_w,
+                           const lv_draw_label_dsc_t *dsc, const char *txt);
+
+// True if `font` is a single-range, unkerned, 1bpp font the fast path can draw.
+bool mono_font_supported(const lv_font_t *font);
+
+// True if the fast path can honour every field of `dsc` except the font.
+bool mono_label_dsc_supported(const lv_draw_label_dsc_t *dsc);
+
+// Width in pixels of `txt` in `font`, or -1 if the fast path can't draw it.
+lv_coord_t mono_text_width(const lv_font_t *font, const char *txt);
+
+/*
+ * Rasterize `txt` into a packed 1bpp, MSB first bitmap of w x h pixels with
+ * `stride` bytes per row, laid out as lv_canvas_draw_text() would place it
+ * relative to its (x, y). Pixels outside the bitmap are dropped. `txt` must
+ * be drawable by the fast path (mono_text_width() >= 0).
+ */
+void mono_text_render(const lv_font_t *font, const char *txt, uint8_t *bits, lv_coord_t stride,
+                      lv_coord_t w, lv_coord_t h);
@@ -7,72 +7,59 @@ LV_IMG_DECLARE(bt_unbonded);
 LV_IMG_DECLARE(bt);
 LV_IMG_DECLARE(usb);
 
+// Relative to LAYOUT_OUTPUT
 #if !IS_ENABLED(CONFIG_ZMK_SPLIT) || IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL)
-static void draw_usb_connected(lv_obj_t *canvas) {
-  lv_draw_img_dsc_t img_dsc;
-  lv_draw_img_dsc_init(&img_dsc);
-
-  lv_canvas_draw_img(canvas, 0, 34, &usb, &img_dsc);
-  // lv_canvas_draw_img(canvas, 45, 2, &usb, &img_dsc);
-}
-
-static void draw_ble_unbonded(lv_obj_t *canvas) {
-  lv_draw_img_dsc_t img_dsc;
-  lv_draw_img_dsc_init(&img_dsc);
-
-  // 36 - 39
-  lv_canvas_draw_img(canvas, -1, 32, &bt_unbonded, &img_dsc);
-  // lv_canvas_draw_img(canvas, 44, 0, &bt_unbonded, &img_dsc);
-}
+// previously at (45, 2)
+static const struct output_icon usb_connected = {&usb, 0, 2};
+// 36 - 39, previously at (44, 0)
+static const struct output_icon ble_unbonded = {&bt_unbonded, -1, 0};
 #endif
 
-static void draw_ble_disconnected(lv_obj_t *canvas) {
-  lv_draw_img_dsc_t img_dsc;
-  lv_draw_img_dsc_init(&img_dsc);
-
-  lv_canvas_draw_img(canvas, 4, 32, &bt_no_signal, &img_dsc);
-  // lv_canvas_draw_img(canvas, 49, 0, &bt_no_signal, &img_dsc);
-}
-
-static void draw_ble_connected(lv_obj_t *canvas) {
-  lv_draw_img_dsc_t img_dsc;
-  lv_draw_img_dsc_init(&img_dsc);
-
-  lv_canvas_draw_img(canvas, 4, 32, &bt, &img_dsc);
-  // lv_canvas_draw_img(canvas, 49, 0, &bt, &img_dsc);
-}
-
-void draw_output_status(lv_obj_t *canvas, const struct status_state *state) {
-  /*
-   * WHITOUT BACKGROUND
-  lv_draw_rect_dsc_t rect_white_dsc;
-  init_rect_dsc(&rect_white_dsc, LVGL_FOREGROUND);
-  lv_canvas_draw_rect(canvas, -3, 32, 24, 15, &rect_white_dsc);
-  */
+// previously at (49, 0)
+static const struct output_icon ble_disconnected = {&bt_no_signal, 4, 0};
+static const struct output_icon ble_connected = {&bt, 4, 0};
 
+const struct output_icon *output_status_icon(const struct status_state *state) {
 #if !IS_ENABLED(CONFIG_ZMK_SPLIT) || IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL)
   switch (state->selected_endpoint.transport) {
   case ZMK_TRANSPORT_USB:
-    draw_usb_connected(canvas);
-    break;
+    return &usb_connected;
 
   case ZMK_TRANSPORT_BLE:
     if (state->active_profile_bonded) {
       if (state->active_profile_connected) {
-        draw_ble_connected(canvas);
+        return &ble_connected;
       } else {
-        draw_ble_disconnected(canvas);
+        return &ble_disconnected;
       }
     } else {
-      draw_ble_unbonded(canvas);
+      return &ble_unbonded;
     }
-    break;
   }
+
+  return NULL;
 #else
   if (state->connected) {
-    draw_ble_connected(canvas);
+    return &ble_connected;
   } else {
-    draw_ble_disconnected(canvas);
+    return &ble_disconnected;
   }
 #endif
 }
+
+void draw_output_status(draw_target_t *canvas, const lv_area_t *area,
+                        const struct draw_dscs *dscs,
+                        const struct status_state *state) {
+  /*
+   * WHITOUT BACKGROUND
+  lv_draw_rect_dsc_t rect_white_dsc;
+  init_rect_dsc(&rect_white_dsc, LVGL_FOREGROUND);
+  draw_rect(canvas, -3, 32, 24, 15, &rect_white_dsc);
+  */
+
+  const struct output_icon *icon = output_status_icon(state);
+  if (icon != NULL) {
+    draw_img(canvas, area->x1 + icon->x, area->y1 + icon->y, icon->img,
+             &dscs->img);
+  }
+}
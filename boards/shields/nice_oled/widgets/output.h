@@ -17,4 +17,15 @@ struct peripheral_status_state {
 };
 #endif
 
-void draw_output_status(lv_obj_t *canvas, const struct status_state *state);
+struct output_icon {
+  const lv_img_dsc_t *img;
+  lv_coord_t x;
+  lv_coord_t y;
+};
+
+// Icon for the current transport, or NULL when there is none to show. The
+// position is relative to LAYOUT_OUTPUT.
+const struct output_icon *output_status_icon(const struct status_state *state);
+void draw_output_status(draw_target_t *canvas, const lv_area_t *area,
+                        const struct draw_dscs *dscs,
+                        const struct status_state *state);
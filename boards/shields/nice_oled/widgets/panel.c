@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <errno.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/kernel.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include "panel.h"
+
+#define PANEL_NODE DT_CHOSEN(zephyr_display)
+
+#if DT_HAS_CHOSEN(zephyr_display) && DT_NODE_HAS_COMPAT(PANEL_NODE, solomon_ssd1306fb) &&        \
+    DT_ON_BUS(PANEL_NODE, i2c)
+#define PANEL_SSD1306_I2C 1
+#include <zephyr/drivers/i2c.h>
+
+// Control byte for "every following byte is a command" (Co = 0, D/C# = 0)
+#define SSD1306_CONTROL_ALL_BYTES_CMD 0x00
+
+#define PANEL_SEGMENT_REMAP DT_PROP(PANEL_NODE, segment_remap)
+#define PANEL_COM_INVDIR DT_PROP(PANEL_NODE, com_invdir)
+
+static const struct i2c_dt_spec panel_i2c = I2C_DT_SPEC_GET(PANEL_NODE);
+#else
+#define PANEL_SSD1306_I2C 0
+#define PANEL_SEGMENT_REMAP 0
+#define PANEL_COM_INVDIR 0
+#endif
+
+// The status layout is portrait, the panel landscape: every orientation
+// starts from this rotation, 180 degrees adds the controller flip
+#define PORTRAIT_ROTATION 900
+
+#define ORIENTATION_FLIP IS_ENABLED(CONFIG_NICE_OLED_ORIENTATION_180)
+#define ORIENTATION_MIRRORED                                                                       \
+    (IS_ENABLED(CONFIG_NICE_OLED_ORIENTATION_MIRROR_X) ||                                          \
+     IS_ENABLED(CONFIG_NICE_OLED_ORIENTATION_MIRROR_Y))
+
+BUILD_ASSERT(PANEL_SSD1306_I2C || !(ORIENTATION_FLIP || ORIENTATION_MIRRORED),
+             "The 180 degree and mirrored orientations need an SSD1306 on I2C as zephyr,display");
+
+static int16_t software_rotation = PORTRAIT_ROTATION;
+
+bool panel_has_controller(void) {
+#if PANEL_SSD1306_I2C
+    return i2c_is_ready_dt(&panel_i2c);
+#else
+    return false;
+#endif
+}
+
+int panel_send_commands(const uint8_t *cmds, size_t len) {
+#if PANEL_SSD1306_I2C
+    return i2c_burst_write_dt(&panel_i2c, SSD1306_CONTROL_ALL_BYTES_CMD, cmds, len);
+#else
+    return -ENOTSUP;
+#endif
+}
+
+int panel_apply_orientation(void) {
+    // A 180 degree turn is a segment remap plus a reversed COM scan, both
+    // relative to whatever the devicetree already configured.
+    bool flip = ORIENTATION_FLIP;
+
+    software_rotation = PORTRAIT_ROTATION;
+
+    if (!flip && !ORIENTATION_MIRRORED) {
+        return 0;
+    }
+
+    if (!panel_has_controller()) {
+        // The controller did not come up: turn the view around in software
+        if (flip) {
+            software_rotation += 1800;
+        }
+        if (ORIENTATION_MIRRORED) {
+            LOG_WRN("SSD1306 not ready, mirroring ignored");
+        }
+        return -ENODEV;
+    }
+
+    bool remap = PANEL_SEGMENT_REMAP ^ flip ^ IS_ENABLED(CONFIG_NICE_OLED_ORIENTATION_MIRROR_X);
+    bool invdir = PANEL_COM_INVDIR ^ flip ^ IS_ENABLED(CONFIG_NICE_OLED_ORIENTATION_MIRROR_Y);
+    uint8_t cmds[] = {
+        remap ? SSD1306_CMD_SEGMENT_REMAP_REVERSED : SSD1306_CMD_SEGMENT_REMAP_NORMAL,
+        invdir ? SSD1306_CMD_COM_SCAN_REVERSED : SSD1306_CMD_COM_SCAN_NORMAL,
+    };
+
+    int ret = panel_send_commands(cmds, sizeof(cmds));
+    if (ret < 0) {
+        LOG_ERR("Failed to set panel orientation (%d)", ret);
+        if (flip) {
+            software_rotation += 1800;
+        }
+        return ret;
+    }
+
+    return 0;
+}
+
+int16_t panel_software_rotation(void) { return software_rotation; }
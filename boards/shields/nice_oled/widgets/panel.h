@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Direct access to the SSD1306 controller behind the chosen zephyr,display
+ * node, for the few settings the Zephyr display API does not expose.
+ */
+
+#define SSD1306_CMD_SEGMENT_REMAP_NORMAL 0xA0
+#define SSD1306_CMD_SEGMENT_REMAP_REVERSED 0xA1
+#define SSD1306_CMD_COM_SCAN_NORMAL 0xC0
+#define SSD1306_CMD_COM_SCAN_REVERSED 0xC8
+
+bool panel_has_controller(void);
+int panel_send_commands(const uint8_t *cmds, size_t len);
+
+/*
+ * Apply CONFIG_NICE_OLED_ORIENTATION_*, relative to the landscape view. The
+ * portrait layout always needs the 90 degree software rotation; 180 degrees
+ * and mirroring are done by the SSD1306. panel_software_rotation() returns
+ * what is left for rotate_canvas() in 0.1 degree units: 900, or 2700 if the
+ * controller could not be reached for a 180 degree flip.
+ */
+int panel_apply_orientation(void);
+int16_t panel_software_rotation(void);
@@ -3,4 +3,13 @@
 #include <lvgl.h>
 #include "util.h"
 
-void draw_profile_status(lv_obj_t *canvas, const struct status_state *state);
\ No newline at end of file
+void draw_profile_chrome(draw_target_t *canvas, const lv_area_t *area,
+                         const struct draw_dscs *dscs);
+// Active profile marker on the strip
+void draw_profile_status(draw_target_t *canvas, const lv_area_t *area,
+                         const struct draw_dscs *dscs,
+                         const struct status_state *state);
+// Active profile number next to the output icon
+void draw_profile_number(draw_target_t *canvas, const lv_area_t *area,
+                         const struct draw_dscs *dscs,
+                         const struct status_state *state);
\ No newline at end of file
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <errno.h>
+#include <lvgl.h>
+#include <zephyr/kernel.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include "render_stats.h"
+
+static uint32_t update_cycles;
+static uint32_t updates;
+static uint32_t refresh_ms;
+static uint32_t refresh_px;
+static uint32_t refreshes;
+
+void render_stats_update(uint32_t cycles) {
+    update_cycles += cycles;
+    updates++;
+}
+
+static void render_stats_monitor_cb(lv_disp_drv_t *drv, uint32_t time, uint32_t px) {
+    refresh_ms += time;
+    refresh_px += px;
+
+    if (++refreshes < CONFIG_NICE_OLED_RENDER_STATS_INTERVAL) {
+        return;
+    }
+
+    uint32_t update_us = updates ? k_cyc_to_us_floor32(update_cycles / updates) : 0;
+    LOG_INF("%s renderer: update %u us, refresh %u.%02u ms, %u px per refresh",
+            IS_ENABLED(CONFIG_NICE_OLED_RENDERER_OBJECTS) ? "objects" : "canvas", update_us,
+            refresh_ms / refreshes, (refresh_ms * 100 / refreshes) % 100, refresh_px / refreshes);
+
+    update_cycles = 0;
+    updates = 0;
+    refresh_ms = 0;
+    refresh_px = 0;
+    refreshes = 0;
+}
+
+int render_stats_init(void) {
+    lv_disp_t *disp = lv_disp_get_default();
+    if (disp == NULL) {
+        return -ENODEV;
+    }
+
+    disp->driver->monitor_cb = render_stats_monitor_cb;
+    return 0;
+}
@@ -0,0 +1,21 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/*
+ * Frame time logging used to compare the renderers. Widgets report how long
+ * they spent updating the screen, LVGL reports how long the refresh took and
+ * how many pixels it redrew; averages are logged every
+ * CONFIG_NICE_OLED_RENDER_STATS_INTERVAL refreshes.
+ */
+
+int render_stats_init(void);
+
+// Account `cycles` (k_cycle_get_32() units) spent preparing one update.
+void render_stats_update(uint32_t cycles);
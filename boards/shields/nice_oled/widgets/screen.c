@@ -22,50 +22,148 @@
  #include <zmk/events/endpoint_changed.h>
  #include <zmk/events/layer_state_changed.h>
  #include <zmk/events/usb_conn_state_changed.h>
+ #include <zmk/events/wpm_state_changed.h>
+ #include <zmk/wpm.h>
  
  // Widget modules
  #include "battery.h"
  #include "layer.h"
+ #include "lvgl_service.h"
  #include "output.h"
  #include "profile.h"
  #include "screen.h"
+ #include "status_widget.h"
+ #include "wpm.h"
+
+ #if IS_ENABLED(CONFIG_NICE_OLED_STATUS_SNAPSHOT)
+ #include "status_snapshot.h"
+ #endif
+
+ #if IS_ENABLED(CONFIG_NICE_OLED_RENDER_STATS)
+ #include "render_stats.h"
+ #endif
  
- // Optional: Luna and modifiers
- #if IS_ENABLED(CONFIG_NICE_OLED_WIDGET_WPM)
+ // Optional: Luna, driven by WPM, modifiers and lock keys
+ #if IS_ENABLED(CONFIG_NICE_OLED_LUNA)
  #include "luna.h"
  static struct zmk_widget_luna luna_widget;
  #endif
  
- #if IS_ENABLED(CONFIG_NICE_OLED_WIDGET_MODIFIERS_INDICATORS)
- #include "modifiers.h"
- static struct zmk_widget_modifiers modifiers_widget;
- #endif
+ static sys_slist_t widgets = SYS_SLIST_STATIC_INIT(&widgets);
  
- #if IS_ENABLED(CONFIG_NICE_OLED_WIDGET_HID_INDICATORS)
- #include "hid_indicators.h"
- static struct zmk_widget_hid_indicators hid_indicators_widget;
+ /** ───── Layout ─────────────────────────────────────────── */
+ STATUS_WIDGET_DEFINE(status_output, LAYOUT_OUTPUT, draw_output_status, NULL, STATUS_EVENT_OUTPUT);
+ STATUS_WIDGET_DEFINE(status_profile_number, LAYOUT_PROFILE_NUMBER, draw_profile_number, NULL,
+                      STATUS_EVENT_OUTPUT);
+ STATUS_WIDGET_DEFINE(status_battery, LAYOUT_BATTERY, draw_battery_status, NULL,
+                      STATUS_EVENT_BATTERY);
+ #if IS_ENABLED(CONFIG_NICE_OLED_WIDGET_WPM_METER)
+ STATUS_WIDGET_DEFINE(status_wpm, LAYOUT_WPM, draw_wpm_status, draw_wpm_chrome, STATUS_EVENT_WPM);
  #endif
- 
- static sys_slist_t widgets = SYS_SLIST_STATIC_INIT(&widgets);
+ STATUS_WIDGET_DEFINE(status_profiles, LAYOUT_PROFILES, draw_profile_status, draw_profile_chrome,
+                      STATUS_EVENT_OUTPUT);
+ STATUS_WIDGET_DEFINE(status_layer, LAYOUT_LAYER, draw_layer_status, NULL, STATUS_EVENT_LAYER);
  
  /** ───── Draw everything to canvas ───────────────────────── */
- static void draw_canvas(lv_obj_t *widget, lv_color_t cbuf[], const struct status_state *state) {
-     lv_obj_t *canvas = lv_obj_get_child(widget, 0);
-     draw_background(canvas);
-     draw_output_status(canvas, state);
-     draw_battery_status(canvas, state);
-     draw_profile_status(canvas, state);
-     draw_layer_status(canvas, state);
-     rotate_canvas(canvas, cbuf);
+ #if IS_ENABLED(CONFIG_NICE_OLED_RENDERER_OBJECTS)
+ static void render(struct zmk_widget_screen *widget, uint8_t events) {
+     screen_objects_update(&widget->objects, &widget->state);
+ }
+ #else
+ static void draw_chrome_layer(draw_target_t *canvas, const struct draw_dscs *dscs) {
+     status_widgets_draw_chrome(canvas, dscs);
+ }
+
+ static void draw_status(draw_target_t *target, const struct zmk_widget_screen *widget,
+                         const lv_area_t *area) {
+     status_widgets_draw(target, area, &widget->dscs, &widget->state);
+ }
+
+ #if IS_ENABLED(CONFIG_NICE_OLED_ENGINE_DIRECT)
+ static void render(struct zmk_widget_screen *widget, uint8_t events) {
+     struct fb *fb = fb_get();
+ #if IS_ENABLED(CONFIG_NICE_OLED_DISPLAY_LIST)
+     struct display_list *list = display_list_begin(&widget->lists, fb);
+     draw_chrome_layer(list, &widget->dscs);
+     draw_status(list, widget, NULL);
+     if (!display_list_commit(&widget->lists)) {
+         return;
+     }
+     fb_clear(fb);
+     display_list_replay(list);
+ #else
+     fb_clear(fb);
+     draw_chrome_layer(fb, &widget->dscs);
+     draw_status(fb, widget, NULL);
+ #endif
+     fb_flush(fb);
+ }
+ #else
+ static void render(struct zmk_widget_screen *widget, uint8_t events) {
+     lv_obj_t *view = lv_obj_get_child(widget->obj, CANVAS_VIEW_CHILD);
+     lv_obj_t *canvas = lv_obj_get_child(widget->obj, CANVAS_DRAW_CHILD);
+     const lv_area_t *area = NULL;
+ #if IS_ENABLED(CONFIG_NICE_OLED_DISPLAY_LIST)
+     // Nothing is drawn unless the frame differs from the one on the canvas
+     struct display_list *list = display_list_begin(&widget->lists, canvas);
+     draw_status(list, widget, NULL);
+     if (!display_list_commit(&widget->lists)) {
+         return;
+     }
+     draw_chrome(canvas, widget->cbuf, &widget->chrome, &widget->dscs, draw_chrome_layer, NULL);
+     display_list_replay(list);
+ #else
+     // The drawing canvas still holds the last frame: only the boxes of the
+     // elements that changed are restored, redrawn and rotated into the view
+     lv_area_t dirty;
+     if (widget->chrome.ready) {
+         if (!status_widgets_dirty_area(events, &dirty)) {
+             return;
+         }
+         area = &dirty;
+     }
+     draw_chrome(canvas, widget->cbuf, &widget->chrome, &widget->dscs, draw_chrome_layer, area);
+     draw_status(canvas, widget, area);
+ #endif
+     rotate_canvas(view, widget->cbuf, area);
+ }
+ #endif
+ #endif
+
+ // `events` says which parts of the state changed
+ static void draw_canvas(struct zmk_widget_screen *widget, uint8_t events) {
+     // load_state() collects the state of every listener first and renders once
+     if (widget->booting) {
+         return;
+     }
+ #if IS_ENABLED(CONFIG_NICE_OLED_RENDER_STATS)
+     uint32_t start = k_cycle_get_32();
+     render(widget, events);
+     render_stats_update(k_cycle_get_32() - start);
+ #else
+     render(widget, events);
+ #endif
+ #if IS_ENABLED(CONFIG_NICE_OLED_STATUS_SNAPSHOT)
+     status_snapshot_save(&widget->state);
+ #endif
+     lvgl_service_kick();
  }
  
  /** ───── Battery status ─────────────────────────────────── */
  static void set_battery_status(struct zmk_widget_screen *widget, struct battery_status_state state) {
  #if IS_ENABLED(CONFIG_USB_DEVICE_STACK)
      widget->state.charging = state.usb_present;
+ #endif
+ #if IS_ENABLED(CONFIG_NICE_OLED_STATUS_SNAPSHOT)
+     // Until the first reading the battery reports 0: keep the restored level
+     if (state.level == 0 && widget->restored) {
+         draw_canvas(widget, STATUS_EVENT_BATTERY);
+         return;
+     }
+     widget->restored = false;
  #endif
      widget->state.battery = state.level;
-     draw_canvas(widget->obj, widget->cbuf, &widget->state);
+     draw_canvas(widget, STATUS_EVENT_BATTERY);
  }
  
  static void battery_status_update_cb(struct battery_status_state state) {
@@ -96,7 +194,7 @@
  static void set_layer_status(struct zmk_widget_screen *widget, struct layer_status_state state) {
      widget->state.layer_index = state.index;
      widget->state.layer_label = state.label;
-     draw_canvas(widget->obj, widget->cbuf, &widget->state);
+     draw_canvas(widget, STATUS_EVENT_LAYER);
  }
  
  static void layer_status_update_cb(struct layer_status_state state) {
@@ -121,7 +219,7 @@
      widget->state.active_profile_index = state->active_profile_index;
      widget->state.active_profile_connected = state->active_profile_connected;
      widget->state.active_profile_bonded = state->active_profile_bonded;
-     draw_canvas(widget->obj, widget->cbuf, &widget->state);
+     draw_canvas(widget, STATUS_EVENT_OUTPUT);
  }
  
  static void output_status_update_cb(struct output_status_state state) {
@@ -150,31 +248,88 @@
  ZMK_SUBSCRIPTION(widget_output_status, zmk_ble_active_profile_changed);
  #endif
  
+ /** ───── WPM ────────────────────────────────────────────── */
+ #if IS_ENABLED(CONFIG_NICE_OLED_WIDGET_WPM_METER)
+ static void set_wpm_status(struct zmk_widget_screen *widget, struct wpm_status_state state) {
+     wpm_history_push(&widget->state.wpm, state.wpm);
+     draw_canvas(widget, STATUS_EVENT_WPM);
+ }
+
+ static void wpm_status_update_cb(struct wpm_status_state state) {
+     struct zmk_widget_screen *widget;
+     SYS_SLIST_FOR_EACH_CONTAINER(&widgets, widget, node) {
+         set_wpm_status(widget, state);
+     }
+ }
+
+ static struct wpm_status_state wpm_status_get_state(const zmk_event_t *eh) {
+     return (struct wpm_status_state){.wpm = zmk_wpm_get_state()};
+ }
+
+ ZMK_DISPLAY_WIDGET_LISTENER(widget_wpm_status, struct wpm_status_state, wpm_status_update_cb,
+                             wpm_status_get_state);
+ ZMK_SUBSCRIPTION(widget_wpm_status, zmk_wpm_state_changed);
+ #endif
+
  /** ───── Widget entry point ─────────────────────────────── */
- int zmk_widget_screen_init(struct zmk_widget_screen *widget, lv_obj_t *parent) {
-     widget->obj = lv_obj_create(parent);
-     lv_obj_set_size(widget->obj, CANVAS_HEIGHT, CANVAS_WIDTH);
- 
-     lv_obj_t *canvas = lv_canvas_create(widget->obj);
-     lv_obj_align(canvas, LV_ALIGN_TOP_LEFT, 0, 0);
-     lv_canvas_set_buffer(canvas, widget->cbuf, CANVAS_HEIGHT, CANVAS_HEIGHT, LV_IMG_CF_TRUE_COLOR);
- 
-     sys_slist_append(&widgets, &widget->node);
+ // Collect the current state of every listener, then render once
+ static void load_state(struct zmk_widget_screen *widget) {
+     widget->booting = true;
      widget_battery_status_init();
      widget_layer_status_init();
      widget_output_status_init();
+ #if IS_ENABLED(CONFIG_NICE_OLED_WIDGET_WPM_METER)
+     widget_wpm_status_init();
+ #endif
+     widget->booting = false;
+     draw_canvas(widget, STATUS_EVENT_ALL);
+ }
+ 
+ #if IS_ENABLED(CONFIG_NICE_OLED_STATUS_SNAPSHOT)
+ static void load_live_state(struct k_work *work) {
+     struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+     load_state(CONTAINER_OF(dwork, struct zmk_widget_screen, live_work));
+ }
+ #endif
  
- #if IS_ENABLED(CONFIG_NICE_OLED_WIDGET_WPM)
-     zmk_widget_luna_init(&luna_widget, canvas);
-     lv_obj_align(zmk_widget_luna_obj(&luna_widget), LV_ALIGN_TOP_LEFT, 36, 0);
+ int zmk_widget_screen_init(struct zmk_widget_screen *widget, lv_obj_t *parent) {
+     widget->obj = lv_obj_create(parent);
+     lv_obj_set_size(widget->obj, CANVAS_HEIGHT, CANVAS_WIDTH);
+ 
+ #if IS_ENABLED(CONFIG_NICE_OLED_RENDERER_OBJECTS)
+     // Luna and the indicators are positioned in display coordinates
+     lv_obj_t *canvas = widget->obj;
+     screen_objects_init(&widget->objects, widget->obj);
+ #elif IS_ENABLED(CONFIG_NICE_OLED_ENGINE_DIRECT)
+     // Nothing is drawn through LVGL, the object only parents the sprites
+     lv_obj_t *canvas = widget->obj;
+     init_draw_dscs(&widget->dscs);
+ #else
+     canvas_create(widget->obj, widget->view_buf, widget->cbuf);
+     lv_obj_t *canvas = lv_obj_get_child(widget->obj, CANVAS_VIEW_CHILD);
+     init_draw_dscs(&widget->dscs);
  #endif
  
- #if IS_ENABLED(CONFIG_NICE_OLED_WIDGET_HID_INDICATORS)
-     zmk_widget_hid_indicators_init(&hid_indicators_widget, canvas);
+     wpm_history_init(&widget->state.wpm);
+     sys_slist_append(&widgets, &widget->node);
+ #if IS_ENABLED(CONFIG_NICE_OLED_STATUS_SNAPSHOT)
+     // The first frame shows the state from before the reset. The live state
+     // replaces it one refresh period later, once LVGL has flushed that frame
+     widget->restored = status_snapshot_restore(&widget->state);
+     if (widget->restored) {
+         draw_canvas(widget, STATUS_EVENT_ALL);
+         k_work_init_delayable(&widget->live_work, load_live_state);
+         k_work_schedule_for_queue(zmk_display_work_q(), &widget->live_work,
+                                   K_MSEC(LV_DISP_DEF_REFR_PERIOD));
+     } else {
+         load_state(widget);
+     }
+ #else
+     load_state(widget);
  #endif
  
- #if IS_ENABLED(CONFIG_NICE_OLED_WIDGET_MODIFIERS_INDICATORS)
-     zmk_widget_modifiers_init(&modifiers_widget, canvas);
+ #if IS_ENABLED(CONFIG_NICE_OLED_LUNA)
+     zmk_widget_luna_init(&luna_widget, canvas, 36, 0);
  #endif
  
      return 0;
@@ -2,6 +2,7 @@
 #ifndef SCREEN_H_
 #define SCREEN_H_
 
+#include "screen_objects.h"
 #include "util.h"
 #include <lvgl.h>
 #include <zephyr/kernel.h>
@@ -9,8 +10,27 @@
 struct zmk_widget_screen {
   sys_snode_t node;
   lv_obj_t *obj;
-  lv_color_t cbuf[CANVAS_HEIGHT * CANVAS_HEIGHT];
+#if IS_ENABLED(CONFIG_NICE_OLED_RENDERER_OBJECTS)
+  struct screen_objects objects;
+#elif IS_ENABLED(CONFIG_NICE_OLED_ENGINE_DIRECT)
+  struct draw_dscs dscs;
+#else
+  lv_color_t view_buf[CANVAS_HEIGHT * CANVAS_WIDTH];
+  lv_color_t cbuf[CANVAS_WIDTH * CANVAS_HEIGHT];
+  struct chrome_layer chrome;
+  struct draw_dscs dscs;
+#endif
+#if IS_ENABLED(CONFIG_NICE_OLED_DISPLAY_LIST)
+  struct display_lists lists;
+#endif
   struct status_state state;
+  // Set while load_state() collects the state of every listener
+  bool booting;
+#if IS_ENABLED(CONFIG_NICE_OLED_STATUS_SNAPSHOT)
+  // Set while the battery level still comes from the snapshot
+  bool restored;
+  struct k_work_delayable live_work;
+#endif
 };
 
 int zmk_widget_screen_init(struct zmk_widget_screen *widget, lv_obj_t *parent);
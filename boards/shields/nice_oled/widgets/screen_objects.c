@@ -0,0 +1,193 @@
+#include <stdio.h>
+#include <string.h>
+#include <lvgl.h>
+#include <zephyr/kernel.h>
+
+#include "../assets/custom_fonts.h"
+#include "layer.h"
+#include "layout.h"
+#include "output.h"
+#include "panel.h"
+#include "screen_objects.h"
+#include "wpm.h"
+
+LV_IMG_DECLARE(bolt);
+LV_IMG_DECLARE(profiles);
+LV_IMG_DECLARE(gauge);
+LV_IMG_DECLARE(grid);
+
+static const lv_area_t output_area = LAYOUT_OUTPUT;
+static const lv_area_t profile_number_area = LAYOUT_PROFILE_NUMBER;
+static const lv_area_t battery_area = LAYOUT_BATTERY;
+static const lv_area_t profiles_area = LAYOUT_PROFILES;
+static const lv_area_t layer_area = LAYOUT_LAYER;
+static const lv_area_t wpm_area = LAYOUT_WPM;
+
+// Every element is rotated on its own, around the same point rotate_canvas()
+// turns the canvas around. LVGL renders a transformed object through a layer
+// of its own size, so this needs a layer the size of the largest element
+// instead of one for the whole portrait area.
+static void place(lv_obj_t *obj, lv_coord_t x, lv_coord_t y) {
+    lv_obj_set_pos(obj, x, y);
+
+    int16_t angle = panel_software_rotation();
+    if (angle != 0) {
+        lv_point_t pivot = rotation_pivot(angle);
+        lv_obj_set_style_transform_angle(obj, angle, LV_PART_MAIN);
+        lv_obj_set_style_transform_pivot_x(obj, pivot.x - x, LV_PART_MAIN);
+        lv_obj_set_style_transform_pivot_y(obj, pivot.y - y, LV_PART_MAIN);
+    }
+}
+
+static lv_obj_t *create_label(lv_obj_t *parent, const lv_font_t *font, lv_coord_t x,
+                              lv_coord_t y) {
+    lv_obj_t *label = lv_label_create(parent);
+    lv_obj_set_style_text_font(label, font, LV_PART_MAIN);
+    lv_obj_set_style_text_color(label, LVGL_FOREGROUND, LV_PART_MAIN);
+    lv_label_set_text_static(label, "");
+    place(label, x, y);
+    return label;
+}
+
+// LVGL invalidates on every setter call, even when nothing changes
+static void set_label_text(lv_obj_t *label, const char *text) {
+    if (strcmp(lv_label_get_text(label), text) != 0) {
+        lv_label_set_text(label, text);
+    }
+}
+
+static lv_obj_t *create_img(lv_obj_t *parent, const lv_img_dsc_t *img, lv_coord_t x,
+                            lv_coord_t y) {
+    lv_obj_t *obj = lv_img_create(parent);
+    lv_img_set_src(obj, img);
+    place(obj, x, y);
+    return obj;
+}
+
+static void set_hidden(lv_obj_t *obj, bool hidden) {
+    if (lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN) == hidden) {
+        return;
+    }
+    if (hidden) {
+        lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
+    } else {
+        lv_obj_clear_flag(obj, LV_OBJ_FLAG_HIDDEN);
+    }
+}
+
+void screen_objects_init(struct screen_objects *objects, lv_obj_t *parent) {
+    lv_obj_t *panel = lv_obj_create(parent);
+    lv_obj_remove_style_all(panel);
+    // Children sit at their portrait coordinates, outside the landscape panel
+    // until they are rotated
+    lv_obj_clear_flag(panel, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_set_size(panel, CANVAS_HEIGHT, CANVAS_WIDTH);
+    lv_obj_set_pos(panel, 0, 0);
+    lv_obj_set_style_bg_color(panel, LVGL_BACKGROUND, LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(panel, LV_OPA_COVER, LV_PART_MAIN);
+    objects->panel = panel;
+
+    objects->output = lv_img_create(panel);
+
+    objects->battery =
+        create_label(panel, &pixel_operator_mono, battery_area.x1, battery_area.y1);
+    objects->bolt = lv_img_create(panel);
+    lv_img_set_src(objects->bolt, &bolt);
+    place(objects->bolt, battery_area.x1 + 25, battery_area.y1);
+    lv_obj_add_flag(objects->bolt, LV_OBJ_FLAG_HIDDEN);
+
+    lv_obj_t *strip = lv_img_create(panel);
+    lv_img_set_src(strip, &profiles);
+    place(strip, profiles_area.x1, profiles_area.y1);
+
+    objects->profile_dot = lv_obj_create(panel);
+    lv_obj_remove_style_all(objects->profile_dot);
+    lv_obj_set_size(objects->profile_dot, 3, 3);
+    lv_obj_set_style_bg_color(objects->profile_dot, LVGL_FOREGROUND, LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(objects->profile_dot, LV_OPA_COVER, LV_PART_MAIN);
+    place(objects->profile_dot, profiles_area.x1, profiles_area.y1);
+    objects->profile_label = create_label(panel, &pixel_operator_mono_8, profile_number_area.x1,
+                                          profile_number_area.y1);
+    objects->profile_index = 0;
+
+    objects->layer = create_label(panel, &pixel_operator_mono, layer_area.x1, layer_area.y1);
+    lv_obj_set_width(objects->layer, lv_area_get_width(&layer_area));
+    lv_label_set_long_mode(objects->layer, IS_ENABLED(CONFIG_NICE_OLED_LAYER_TICKER)
+                                               ? LV_LABEL_LONG_SCROLL_CIRCULAR
+                                               : LV_LABEL_LONG_CLIP);
+
+#if IS_ENABLED(CONFIG_NICE_OLED_WIDGET_WPM_METER)
+    create_img(panel, &gauge, wpm_area.x1 + WPM_GAUGE_X, wpm_area.y1 + WPM_GAUGE_Y);
+    create_img(panel, &grid, wpm_area.x1 + WPM_GRID_X, wpm_area.y1 + WPM_GRID_Y);
+    // The graph image is placed on the first update, once its position is known
+    objects->graph = lv_img_create(panel);
+
+    objects->needle = lv_line_create(panel);
+    lv_obj_set_style_line_width(objects->needle, 1, LV_PART_MAIN);
+    lv_obj_set_style_line_color(objects->needle, LVGL_FOREGROUND, LV_PART_MAIN);
+    place(objects->needle, wpm_area.x1, wpm_area.y1);
+
+    objects->wpm_label = create_label(panel, &pixel_operator_mono_12, wpm_area.x1,
+                                      wpm_area.y1 + WPM_LABEL_Y);
+#endif
+}
+
+#if IS_ENABLED(CONFIG_NICE_OLED_WIDGET_WPM_METER)
+static void update_wpm(struct screen_objects *objects, const struct status_state *state) {
+    char text[4];
+    uint8_t wpm = wpm_history_latest(&state->wpm);
+
+    snprintf(text, sizeof(text), "%d", wpm);
+    if (strcmp(lv_label_get_text(objects->wpm_label), text) != 0) {
+        lv_label_set_text(objects->wpm_label, text);
+        place(objects->wpm_label, wpm_area.x1 + wpm_label_x(wpm), wpm_area.y1 + WPM_LABEL_Y);
+    }
+
+    lv_point_t points[2];
+    wpm_needle_points(state, points);
+    if (memcmp(points, objects->needle_points, sizeof(points)) != 0) {
+        memcpy(objects->needle_points, points, sizeof(points));
+        lv_line_set_points(objects->needle, objects->needle_points, 2);
+    }
+
+    // The graph alternates between two images, a changed graph is a new source
+    lv_point_t pos;
+    // Same pen as the canvas graph, line_thick
+    const lv_img_dsc_t *img = wpm_graph_img(&state->wpm, 2, &pos);
+    if (lv_img_get_src(objects->graph) != img) {
+        if (lv_img_get_src(objects->graph) == NULL) {
+            place(objects->graph, wpm_area.x1 + pos.x, wpm_area.y1 + pos.y);
+        }
+        lv_img_set_src(objects->graph, img);
+    }
+}
+#endif
+
+void screen_objects_update(struct screen_objects *objects, const struct status_state *state) {
+    char text[14];
+
+    const struct output_icon *icon = output_status_icon(state);
+    set_hidden(objects->output, icon == NULL);
+    if (icon != NULL && lv_img_get_src(objects->output) != icon->img) {
+        lv_img_set_src(objects->output, icon->img);
+        place(objects->output, output_area.x1 + icon->x, output_area.y1 + icon->y);
+    }
+
+    snprintf(text, sizeof(text), state->charging ? "%i" : "%i%%", state->battery);
+    set_label_text(objects->battery, text);
+    set_hidden(objects->bolt, !state->charging);
+
+    snprintf(text, sizeof(text), "%d", state->active_profile_index + 1);
+    set_label_text(objects->profile_label, text);
+    if (objects->profile_index != state->active_profile_index) {
+        objects->profile_index = state->active_profile_index;
+        place(objects->profile_dot, profiles_area.x1 + state->active_profile_index * 7,
+              profiles_area.y1);
+    }
+
+    set_label_text(objects->layer, layer_status_text(state));
+
+#if IS_ENABLED(CONFIG_NICE_OLED_WIDGET_WPM_METER)
+    update_wpm(objects, state);
+#endif
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <lvgl.h>
+#include "util.h"
+
+/*
+ * Retained mode rendering of the central status screen: every element is its
+ * own LVGL object on a panel the size of the display, laid out in the same
+ * portrait coordinates the canvas widgets draw at and rotated into place by
+ * LVGL one element at a time. An update only touches the objects whose content
+ * changed, so LVGL redraws just those areas.
+ */
+struct screen_objects {
+    lv_obj_t *panel;
+    lv_obj_t *output;
+    lv_obj_t *battery;
+    lv_obj_t *bolt;
+    lv_obj_t *profile_label;
+    lv_obj_t *profile_dot;
+    lv_obj_t *layer;
+    int profile_index;
+#if IS_ENABLED(CONFIG_NICE_OLED_WIDGET_WPM_METER)
+    lv_obj_t *wpm_label;
+    lv_obj_t *needle;
+    lv_obj_t *graph;
+    // lv_line keeps a pointer to its points
+    lv_point_t needle_points[2];
+#endif
+};
+
+void screen_objects_init(struct screen_objects *objects, lv_obj_t *parent);
+void screen_objects_update(struct screen_objects *objects, const struct status_state *state);
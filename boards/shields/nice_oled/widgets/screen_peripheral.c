@@ -15,26 +15,83 @@ LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 
 #include "animation.h"
 #include "battery.h"
+#include "lvgl_service.h"
 #include "output.h"
 #include "screen_peripheral.h"
+#include "status_widget.h"
 
 static sys_slist_t widgets = SYS_SLIST_STATIC_INIT(&widgets);
 
+/**
+ * Layout
+ **/
+
+STATUS_WIDGET_DEFINE(status_output, LAYOUT_OUTPUT, draw_output_status, NULL, STATUS_EVENT_OUTPUT);
+STATUS_WIDGET_DEFINE(status_battery, LAYOUT_BATTERY, draw_battery_status, NULL,
+                     STATUS_EVENT_BATTERY);
+
 /**
  * Draw canvas
  **/
 
-static void draw_canvas(lv_obj_t *widget, lv_color_t cbuf[], const struct status_state *state) {
-    lv_obj_t *canvas = lv_obj_get_child(widget, 0);
+static void draw_status(draw_target_t *target, const struct zmk_widget_screen *widget) {
+    status_widgets_draw(target, NULL, &widget->dscs, &widget->state);
+}
+
+#if IS_ENABLED(CONFIG_NICE_OLED_ENGINE_DIRECT)
+static void draw_canvas(struct zmk_widget_screen *widget) {
+    struct fb *fb = fb_get();
+
+    if (widget->booting) {
+        return;
+    }
+
+#if IS_ENABLED(CONFIG_NICE_OLED_DISPLAY_LIST)
+    struct display_list *list = display_list_begin(&widget->lists, fb);
+    draw_status(list, widget);
+    if (!display_list_commit(&widget->lists)) {
+        return;
+    }
+    fb_clear(fb);
+    display_list_replay(list);
+#else
+    fb_clear(fb);
+    draw_status(fb, widget);
+#endif
+    fb_flush(fb);
+}
+#else
+static void draw_canvas(struct zmk_widget_screen *widget) {
+    lv_obj_t *view = lv_obj_get_child(widget->obj, CANVAS_VIEW_CHILD);
+    lv_obj_t *canvas = lv_obj_get_child(widget->obj, CANVAS_DRAW_CHILD);
+
+    // Init collects the state of every listener first and renders once
+    if (widget->booting) {
+        return;
+    }
+
+#if IS_ENABLED(CONFIG_NICE_OLED_DISPLAY_LIST)
+    // Record the frame first and leave the canvas alone if nothing changed
+    struct display_list *list = display_list_begin(&widget->lists, canvas);
+    draw_status(list, widget);
+    if (!display_list_commit(&widget->lists)) {
+        return;
+    }
+    draw_chrome(canvas, widget->cbuf, &widget->chrome, &widget->dscs, NULL, NULL);
+    display_list_replay(list);
+#else
+    // Start from the cached background
+    draw_chrome(canvas, widget->cbuf, &widget->chrome, &widget->dscs, NULL, NULL);
 
     // Draw widgets
-    draw_background(canvas);
-    draw_output_status(canvas, state);
-    draw_battery_status(canvas, state);
+    draw_status(canvas, widget);
+#endif
 
     // Rotate for horizontal display
-    rotate_canvas(canvas, cbuf);
+    rotate_canvas(view, widget->cbuf, NULL);
+    lvgl_service_kick();
 }
+#endif
 
 /**
  * Battery status
@@ -49,7 +106,7 @@ static void set_battery_status(struct zmk_widget_screen *widget,
 
     widget->state.battery = state.level;
 
-    draw_canvas(widget->obj, widget->cbuf, &widget->state);
+    draw_canvas(widget);
 }
 
 static void battery_status_update_cb(struct battery_status_state state) {
@@ -88,7 +145,7 @@ static void set_connection_status(struct zmk_widget_screen *widget,
                                   struct peripheral_status_state state) {
     widget->state.connected = state.connected;
 
-    draw_canvas(widget->obj, widget->cbuf, &widget->state);
+    draw_canvas(widget);
 }
 
 static void output_status_update_cb(struct peripheral_status_state state) {
@@ -108,14 +165,24 @@ int zmk_widget_screen_init(struct zmk_widget_screen *widget, lv_obj_t *parent) {
     widget->obj = lv_obj_create(parent);
     lv_obj_set_size(widget->obj, CANVAS_HEIGHT, CANVAS_WIDTH);
 
-    lv_obj_t *canvas = lv_canvas_create(widget->obj);
-    lv_obj_align(canvas, LV_ALIGN_TOP_LEFT, 0, 0);
-    lv_canvas_set_buffer(canvas, widget->cbuf, CANVAS_HEIGHT, CANVAS_HEIGHT, LV_IMG_CF_TRUE_COLOR);
+#if IS_ENABLED(CONFIG_NICE_OLED_ENGINE_DIRECT)
+    lv_obj_t *canvas = widget->obj;
+#else
+    canvas_create(widget->obj, widget->view_buf, widget->cbuf);
+    lv_obj_t *canvas = lv_obj_get_child(widget->obj, CANVAS_VIEW_CHILD);
+#endif
+    init_draw_dscs(&widget->dscs);
 
+    widget->booting = true;
     sys_slist_append(&widgets, &widget->node);
-    draw_animation(canvas, widget);
     widget_battery_status_init();
     widget_peripheral_status_init();
+    widget->booting = false;
+    draw_canvas(widget);
+
+    // LVGL flushes nothing before this returns, so the animation joins the
+    // same first frame
+    draw_animation(canvas, widget);
 
     return 0;
 }
@@ -7,8 +7,18 @@
 struct zmk_widget_screen {
     sys_snode_t node;
     lv_obj_t *obj;
-    lv_color_t cbuf[CANVAS_HEIGHT * CANVAS_HEIGHT];
+#if !IS_ENABLED(CONFIG_NICE_OLED_ENGINE_DIRECT)
+    lv_color_t view_buf[CANVAS_HEIGHT * CANVAS_WIDTH];
+    lv_color_t cbuf[CANVAS_WIDTH * CANVAS_HEIGHT];
+    struct chrome_layer chrome;
+#endif
+    struct draw_dscs dscs;
+#if IS_ENABLED(CONFIG_NICE_OLED_DISPLAY_LIST)
+    struct display_lists lists;
+#endif
     struct status_state state;
+    // Set while zmk_widget_screen_init() collects the initial state
+    bool booting;
 };
 
 int zmk_widget_screen_init(struct zmk_widget_screen *widget, lv_obj_t *parent);
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdbool.h>
+#include <zephyr/kernel.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include "sprite_pool.h"
+
+struct sprite_slot {
+    lv_obj_t *obj;
+    bool used;
+};
+
+static struct sprite_slot slots[CONFIG_NICE_OLED_SPRITE_POOL];
+
+// The parent went away and took the object with it
+static void sprite_pool_delete_cb(lv_event_t *e) {
+    struct sprite_slot *slot = lv_event_get_user_data(e);
+    slot->obj = NULL;
+    slot->used = false;
+}
+
+static lv_obj_t *sprite_pool_reuse(struct sprite_slot *slot, lv_obj_t *parent) {
+    slot->used = true;
+    if (lv_obj_get_parent(slot->obj) != parent) {
+        lv_obj_set_parent(slot->obj, parent);
+    }
+    return slot->obj;
+}
+
+lv_obj_t *sprite_pool_get(lv_obj_t *parent) {
+    struct sprite_slot *empty = NULL;
+
+    // Prefer an object that already exists, allocate only when none is free
+    for (int i = 0; i < ARRAY_SIZE(slots); i++) {
+        struct sprite_slot *slot = &slots[i];
+        if (slot->obj != NULL && !slot->used) {
+            return sprite_pool_reuse(slot, parent);
+        }
+        if (slot->obj == NULL && empty == NULL) {
+            empty = slot;
+        }
+    }
+
+    lv_obj_t *obj = lv_animimg_create(parent);
+    lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
+    if (empty == NULL) {
+        LOG_WRN("Sprite pool full, raise CONFIG_NICE_OLED_SPRITE_POOL");
+        return obj;
+    }
+
+    // After the first few animations this should never show up again
+    LOG_DBG("Sprite pool: allocated object %d of %d", (int)(empty - slots) + 1,
+            (int)ARRAY_SIZE(slots));
+    lv_obj_add_event_cb(obj, sprite_pool_delete_cb, LV_EVENT_DELETE, empty);
+    empty->obj = obj;
+    return sprite_pool_reuse(empty, parent);
+}
+
+void sprite_pool_put(lv_obj_t *sprite) {
+    if (sprite == NULL) {
+        return;
+    }
+
+    for (int i = 0; i < ARRAY_SIZE(slots); i++) {
+        if (slots[i].obj == sprite) {
+            lv_anim_del(sprite, NULL);
+            lv_obj_add_flag(sprite, LV_OBJ_FLAG_HIDDEN);
+            slots[i].used = false;
+            return;
+        }
+    }
+
+    // Created while the pool was full
+    lv_obj_del(sprite);
+}
+
+void sprite_pool_trim(void) {
+    int freed = 0;
+
+    for (int i = 0; i < ARRAY_SIZE(slots); i++) {
+        if (slots[i].obj != NULL && !slots[i].used) {
+            // sprite_pool_delete_cb() empties the slot
+            lv_obj_del(slots[i].obj);
+            freed++;
+        }
+    }
+
+    if (freed > 0) {
+        LOG_DBG("Sprite pool: freed %d idle objects", freed);
+    }
+}
@@ -0,0 +1,23 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <lvgl.h>
+
+/*
+ * Animation objects for the LVGL backend. Objects handed back are hidden and
+ * kept instead of deleted, and handed out again with a new parent and source,
+ * so widgets that show and hide an animation on every modifier or lock key
+ * toggle don't allocate from the LVGL heap each time. Up to
+ * CONFIG_NICE_OLED_SPRITE_POOL objects are kept.
+ */
+
+lv_obj_t *sprite_pool_get(lv_obj_t *parent);
+void sprite_pool_put(lv_obj_t *sprite);
+
+// Delete the objects nobody uses, giving their memory back to the LVGL heap.
+void sprite_pool_trim(void);
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/linker/section_tags.h>
+#include <zephyr/sys/crc.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <zmk/keymap.h>
+
+#include "status_snapshot.h"
+
+// A firmware with a different status_state layout never accepts the old copy
+#define SNAPSHOT_MAGIC (0x4e4f5300 ^ sizeof(struct status_state))
+
+struct status_snapshot {
+    uint32_t magic;
+    uint32_t crc;
+    struct status_state state;
+};
+
+static __noinit struct status_snapshot snapshot;
+
+void status_snapshot_save(const struct status_state *state) {
+    snapshot.magic = SNAPSHOT_MAGIC;
+    memcpy(&snapshot.state, state, sizeof(snapshot.state));
+    // The label points into the keymap and is looked up again on restore
+    snapshot.state.layer_label = NULL;
+    snapshot.crc = crc32_ieee((const uint8_t *)&snapshot.state, sizeof(snapshot.state));
+}
+
+bool status_snapshot_restore(struct status_state *state) {
+    if (snapshot.magic != SNAPSHOT_MAGIC ||
+        snapshot.crc != crc32_ieee((const uint8_t *)&snapshot.state, sizeof(snapshot.state))) {
+        LOG_DBG("No status snapshot to restore");
+        return false;
+    }
+
+    memcpy(state, &snapshot.state, sizeof(*state));
+    state->layer_label = zmk_keymap_layer_name(state->layer_index);
+    LOG_DBG("Restored status snapshot: battery %d, layer %d", state->battery,
+            state->layer_index);
+    return true;
+}
@@ -0,0 +1,22 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdbool.h>
+
+#include "util.h"
+
+/*
+ * A copy of the last drawn status_state in RAM that is not cleared at boot,
+ * guarded by a CRC32. After a reset the first frame is drawn from it instead
+ * of from zeros; the listeners' live state replaces it right after.
+ */
+
+void status_snapshot_save(const struct status_state *state);
+
+// Fill `state` from the snapshot, false if there is no valid one.
+bool status_snapshot_restore(struct status_state *state);
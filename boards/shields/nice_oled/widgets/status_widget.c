@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "status_widget.h"
+
+void status_widgets_draw(draw_target_t *canvas, const lv_area_t *area,
+                         const struct draw_dscs *dscs, const struct status_state *state) {
+    STRUCT_SECTION_FOREACH(status_widget, widget) {
+        // Overlapping elements are redrawn too, the area was cleared under them
+        if (area == NULL || _lv_area_is_on(&widget->area, area)) {
+            widget->draw(canvas, &widget->area, dscs, state);
+        }
+    }
+}
+
+void status_widgets_draw_chrome(draw_target_t *canvas, const struct draw_dscs *dscs) {
+    STRUCT_SECTION_FOREACH(status_widget, widget) {
+        if (widget->chrome != NULL) {
+            widget->chrome(canvas, &widget->area, dscs);
+        }
+    }
+}
+
+bool status_widgets_dirty_area(uint8_t events, lv_area_t *dirty) {
+    bool found = false;
+
+    STRUCT_SECTION_FOREACH(status_widget, widget) {
+        if (!(widget->events & events)) {
+            continue;
+        }
+        if (found) {
+            _lv_area_join(dirty, dirty, &widget->area);
+        } else {
+            *dirty = widget->area;
+            found = true;
+        }
+    }
+
+    return found;
+}
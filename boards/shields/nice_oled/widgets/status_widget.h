@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <lvgl.h>
+#include <stdbool.h>
+#include <zephyr/sys/iterable_sections.h>
+#include <zephyr/sys/util.h>
+
+#include "layout.h"
+#include "util.h"
+
+/*
+ * Compile-time registry of the elements on a status screen. Each element is
+ * one const entry in the status_widget iterable section: its box from
+ * layout.h, how to draw it and which status changes affect it. Disabled
+ * elements are simply not defined, so the screen iterates exactly what is
+ * built in.
+ */
+
+enum status_event {
+    STATUS_EVENT_BATTERY = BIT(0),
+    STATUS_EVENT_OUTPUT = BIT(1),
+    STATUS_EVENT_LAYER = BIT(2),
+    STATUS_EVENT_WPM = BIT(3),
+    STATUS_EVENT_ALL = BIT_MASK(4),
+};
+
+typedef void (*status_draw_cb)(draw_target_t *canvas, const lv_area_t *area,
+                               const struct draw_dscs *dscs, const struct status_state *state);
+typedef void (*status_chrome_cb)(draw_target_t *canvas, const lv_area_t *area,
+                                 const struct draw_dscs *dscs);
+
+struct status_widget {
+    lv_area_t area;
+    status_draw_cb draw;
+    // Static part drawn once into the chrome layer, or NULL
+    status_chrome_cb chrome;
+    uint8_t events;
+};
+
+#define STATUS_WIDGET_DEFINE(_name, _area, _draw, _chrome, _events)                                \
+    static const STRUCT_SECTION_ITERABLE(status_widget, _name) = {                                 \
+        .area = _area,                                                                             \
+        .draw = _draw,                                                                             \
+        .chrome = _chrome,                                                                         \
+        .events = _events,                                                                         \
+    }
+
+// Draw every element, or with `area` only those that overlap it.
+void status_widgets_draw(draw_target_t *canvas, const lv_area_t *area,
+                         const struct draw_dscs *dscs, const struct status_state *state);
+void status_widgets_draw_chrome(draw_target_t *canvas, const struct draw_dscs *dscs);
+
+// Union of the boxes affected by `events`, false if there are none.
+bool status_widgets_dirty_area(uint8_t events, lv_area_t *dirty);
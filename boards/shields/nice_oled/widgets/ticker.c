@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+
+#include <zmk/activity.h>
+#include <zmk/display.h>
+#include <zmk/event_manager.h>
+#include <zmk/events/activity_state_changed.h>
+
+#include "bitmap.h"
+#include "mono_text.h"
+#include "ticker.h"
+
+// Blank pixels between the end of the text and its next start
+#define TICKER_GAP 16
+// Hold the start of the text a little longer on every lap
+#define TICKER_HOLD_MS 1000
+
+static sys_slist_t tickers = SYS_SLIST_STATIC_INIT(&tickers);
+
+static void ticker_init_frames(struct ticker *ticker) {
+    for (int i = 0; i < 2; i++) {
+        lv_color32_t *palette = (lv_color32_t *)ticker->bufs[i];
+        palette[0].full = lv_color_to32(LVGL_BACKGROUND);
+        palette[1].full = lv_color_to32(LVGL_FOREGROUND);
+
+        lv_img_dsc_t *img = &ticker->frames[i];
+        img->header.cf = LV_IMG_CF_INDEXED_1BIT;
+        img->header.w = ticker->w;
+        img->header.h = ticker->h;
+        img->data_size = sizeof(ticker->bufs[i]);
+        img->data = ticker->bufs[i];
+    }
+}
+
+// Copy the window at the current offset into the other frame and make it current
+static const lv_img_dsc_t *ticker_render(struct ticker *ticker) {
+    ticker->current ^= 1;
+    uint8_t *bits = &ticker->bufs[ticker->current][2 * sizeof(lv_color32_t)];
+    lv_coord_t first = MIN(ticker->w, ticker->strip_w - ticker->offset);
+
+    bitmap_blit(bits, TICKER_STRIDE, 0, 0, ticker->strip, TICKER_STRIP_STRIDE, ticker->offset,
+                0, first, ticker->h, BITMAP_COPY);
+    if (first < ticker->w) {
+        // Wrapped round to the start of the strip
+        bitmap_blit(bits, TICKER_STRIDE, first, 0, ticker->strip, TICKER_STRIP_STRIDE, 0, 0,
+                    ticker->w - first, ticker->h, BITMAP_COPY);
+    }
+
+    return &ticker->frames[ticker->current];
+}
+
+static void ticker_step(struct k_work *work) {
+    struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+    struct ticker *ticker = CONTAINER_OF(dwork, struct ticker, work);
+
+    // Nothing to watch while the keyboard is idle, the activity listener
+    // starts stepping again
+    if (ticker->strip_w == 0 || zmk_activity_get_state() != ZMK_ACTIVITY_ACTIVE) {
+        return;
+    }
+
+    ticker->offset = (ticker->offset + 1) % ticker->strip_w;
+    backend_patch_img(ticker->backend, ticker->x, ticker->y, ticker_render(ticker));
+
+    uint32_t delay = CONFIG_NICE_OLED_LAYER_TICKER_STEP_MS;
+    if (ticker->offset == 0) {
+        delay += TICKER_HOLD_MS;
+    }
+    k_work_reschedule_for_queue(zmk_display_work_q(), dwork, K_MSEC(delay));
+}
+
+const lv_img_dsc_t *ticker_update(struct ticker *ticker, draw_target_t *target, lv_coord_t x,
+                                  lv_coord_t y, lv_coord_t w, const lv_draw_label_dsc_t *dsc,
+                                  const char *txt) {
+    if (ticker->font == NULL) {
+        k_work_init_delayable(&ticker->work, ticker_step);
+        sys_slist_append(&tickers, &ticker->node);
+    }
+
+    ticker->backend = draw_target_backend(target);
+    if (ticker->font == dsc->font && strcmp(ticker->text, txt) == 0 && ticker->x == x &&
+        ticker->y == y && ticker->w == MIN(w, TICKER_MAX_W)) {
+        return ticker->strip_w > 0 ? &ticker->frames[ticker->current] : NULL;
+    }
+
+    ticker->x = x;
+    ticker->y = y;
+    ticker->w = MIN(w, TICKER_MAX_W);
+    ticker->h = MIN(dsc->font->line_height, TICKER_MAX_H);
+    ticker->font = dsc->font;
+    strncpy(ticker->text, txt, sizeof(ticker->text) - 1);
+    ticker->text[sizeof(ticker->text) - 1] = '\0';
+    ticker->offset = 0;
+    ticker->strip_w = 0;
+
+    lv_coord_t width = mono_label_dsc_supported(dsc) ? mono_text_width(dsc->font, txt) : -1;
+    if (width <= ticker->w) {
+        // Fits, or can't be rasterized here: a plain, clipped label
+        k_work_cancel_delayable(&ticker->work);
+        return NULL;
+    }
+
+    ticker->strip_w = MIN(width + TICKER_GAP, TICKER_STRIP_STRIDE * 8);
+    mono_text_render(dsc->font, txt, ticker->strip, TICKER_STRIP_STRIDE, ticker->strip_w,
+                     ticker->h);
+    ticker_init_frames(ticker);
+    k_work_reschedule_for_queue(zmk_display_work_q(), &ticker->work,
+                                K_MSEC(TICKER_HOLD_MS + CONFIG_NICE_OLED_LAYER_TICKER_STEP_MS));
+
+    return ticker_render(ticker);
+}
+
+static int ticker_activity_listener(const zmk_event_t *eh) {
+    const struct zmk_activity_state_changed *ev = as_zmk_activity_state_changed(eh);
+    if (ev == NULL) {
+        return ZMK_EV_EVENT_BUBBLE;
+    }
+
+    struct ticker *ticker;
+    SYS_SLIST_FOR_EACH_CONTAINER(&tickers, ticker, node) {
+        if (ev->state != ZMK_ACTIVITY_ACTIVE) {
+            k_work_cancel_delayable(&ticker->work);
+        } else if (ticker->strip_w > 0) {
+            k_work_reschedule_for_queue(zmk_display_work_q(), &ticker->work,
+                                        K_MSEC(CONFIG_NICE_OLED_LAYER_TICKER_STEP_MS));
+        }
+    }
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+ZMK_LISTENER(ticker, ticker_activity_listener);
+ZMK_SUBSCRIPTION(ticker, zmk_activity_state_changed);
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <lvgl.h>
+#include <stdbool.h>
+#include <zephyr/kernel.h>
+
+#include "util.h"
+
+/*
+ * Text that scrolls through a box too narrow for it. The text is rasterized
+ * once into a strip; each step copies the visible window of the strip into a
+ * 1 bit image and patches only that box on the display, without a redraw of
+ * the screen. Full redraws draw the current window with draw_img(). Stepping
+ * stops while the keyboard is idle and resumes when it becomes active.
+ */
+
+#define TICKER_TEXT_LEN 32
+#define TICKER_MAX_W CANVAS_WIDTH
+#define TICKER_MAX_H 16
+#define TICKER_STRIP_STRIDE 40
+#define TICKER_STRIDE DIV_ROUND_UP(TICKER_MAX_W, 8)
+
+struct ticker {
+    lv_coord_t x;
+    lv_coord_t y;
+    lv_coord_t w;
+    lv_coord_t h;
+    draw_backend_t *backend;
+    const lv_font_t *font;
+    char text[TICKER_TEXT_LEN];
+    // Text width plus the gap before it comes round again, 0 when not scrolling
+    lv_coord_t strip_w;
+    lv_coord_t offset;
+    uint8_t strip[TICKER_STRIP_STRIDE * TICKER_MAX_H];
+    lv_img_dsc_t frames[2];
+    uint8_t bufs[2][2 * sizeof(lv_color32_t) + TICKER_STRIDE * TICKER_MAX_H] __aligned(4);
+    uint8_t current;
+    struct k_work_delayable work;
+    sys_snode_t node;
+};
+
+/*
+ * Show `txt` in the w x h box at (x, y) of `target`. Returns the image to
+ * draw when the text has to scroll, or NULL when it fits and should be drawn
+ * as a plain label. Calling it again with the same text keeps the position.
+ */
+const lv_img_dsc_t *ticker_update(struct ticker *ticker, draw_target_t *target, lv_coord_t x,
+                                  lv_coord_t y, lv_coord_t w, const lv_draw_label_dsc_t *dsc,
+                                  const char *txt);
@@ -1,4 +1,6 @@
 #include "util.h"
+#include "../assets/custom_fonts.h"
+#include "panel.h"
 #include <ctype.h>
 #include <zephyr/kernel.h>
 
@@ -8,29 +10,188 @@ void to_uppercase(char *str) {
   }
 }
 
-void rotate_canvas(lv_obj_t *canvas, lv_color_t cbuf[]) {
-  static lv_color_t cbuf_tmp[CANVAS_HEIGHT * CANVAS_HEIGHT];
-  memcpy(cbuf_tmp, cbuf, sizeof(cbuf_tmp));
+// Pivots keep the visible CANVAS_HEIGHT x CANVAS_WIDTH area in place
+lv_point_t rotation_pivot(int16_t angle) {
+  lv_point_t pivot = {.x = CANVAS_HEIGHT / 2, .y = CANVAS_HEIGHT / 2};
+  if (angle == 1800) {
+    pivot.y = CANVAS_WIDTH / 2;
+  } else if (angle == 2700) {
+    pivot.x = CANVAS_WIDTH / 2;
+    pivot.y = CANVAS_WIDTH / 2;
+  }
+  return pivot;
+}
+
+// Where rotating by `angle` around `pivot` moves the pixel at (x, y)
+lv_point_t rotation_map(int16_t angle, lv_point_t pivot, lv_coord_t x,
+                        lv_coord_t y) {
+  switch (angle) {
+  case 900:
+    return (lv_point_t){pivot.x + pivot.y - 1 - y, pivot.y - pivot.x + x};
+  case 1800:
+    return (lv_point_t){2 * pivot.x - 1 - x, 2 * pivot.y - 1 - y};
+  case 2700:
+    return (lv_point_t){pivot.x - pivot.y + y, pivot.x + pivot.y - 1 - x};
+  default:
+    return (lv_point_t){x, y};
+  }
+}
 
-  lv_img_dsc_t img;
-  img.data = (void *)cbuf_tmp;
-  img.header.cf = LV_IMG_CF_TRUE_COLOR;
-  img.header.w = CANVAS_HEIGHT;
-  img.header.h = CANVAS_HEIGHT;
+#if !IS_ENABLED(CONFIG_NICE_OLED_ENGINE_DIRECT)
+static lv_obj_t *create_canvas(lv_obj_t *parent, lv_color_t buf[],
+                               lv_coord_t w, lv_coord_t h) {
+  lv_obj_t *canvas = lv_canvas_create(parent);
+  lv_obj_align(canvas, LV_ALIGN_TOP_LEFT, 0, 0);
+  lv_canvas_set_buffer(canvas, buf, w, h, LV_IMG_CF_TRUE_COLOR);
+  return canvas;
+}
+
+void canvas_create(lv_obj_t *parent, lv_color_t view_buf[], lv_color_t cbuf[]) {
+  lv_obj_t *view = create_canvas(parent, view_buf, CANVAS_HEIGHT, CANVAS_WIDTH);
+  lv_canvas_fill_bg(view, LVGL_BACKGROUND, LV_OPA_COVER);
 
-  lv_canvas_fill_bg(canvas, LVGL_BACKGROUND, LV_OPA_COVER);
-  lv_canvas_transform(canvas, &img, 900, LV_IMG_ZOOM_NONE, -1, 0,
-                      CANVAS_HEIGHT / 2, CANVAS_HEIGHT / 2, false);
+  // Hidden, so LVGL ignores the invalidations of the lv_canvas_draw_*() calls
+  lv_obj_t *canvas = create_canvas(parent, cbuf, CANVAS_WIDTH, CANVAS_HEIGHT);
+  lv_obj_add_flag(canvas, LV_OBJ_FLAG_HIDDEN);
 }
 
-void draw_background(lv_obj_t *canvas) {
-  lv_draw_rect_dsc_t rect_black_dsc;
-  init_rect_dsc(&rect_black_dsc, LVGL_BACKGROUND);
+void rotate_canvas(lv_obj_t *view, const lv_color_t cbuf[],
+                   const lv_area_t *area) {
+  lv_img_dsc_t *img = lv_canvas_get_img(view);
+  lv_color_t *vbuf = (lv_color_t *)img->data;
+  lv_coord_t view_w = img->header.w;
+  lv_coord_t view_h = img->header.h;
+  int16_t angle = panel_software_rotation();
+  lv_point_t pivot = rotation_pivot(angle);
 
+  lv_area_t clip;
+  const lv_area_t full = {0, 0, CANVAS_WIDTH - 1, CANVAS_HEIGHT - 1};
+  if (!_lv_area_intersect(&clip, area != NULL ? area : &full, &full)) {
+    return;
+  }
+
+  for (lv_coord_t y = clip.y1; y <= clip.y2; y++) {
+    for (lv_coord_t x = clip.x1; x <= clip.x2; x++) {
+      lv_point_t p = rotation_map(angle, pivot, x, y);
+      if (p.x < 0 || p.y < 0 || p.x >= view_w || p.y >= view_h) {
+        continue;
+      }
+      vbuf[p.y * view_w + p.x] = cbuf[y * CANVAS_WIDTH + x];
+    }
+  }
+
+  // Only where the rotated area landed, in screen coordinates
+  lv_point_t a = rotation_map(angle, pivot, clip.x1, clip.y1);
+  lv_point_t b = rotation_map(angle, pivot, clip.x2, clip.y2);
+  lv_area_t dirty = {MIN(a.x, b.x), MIN(a.y, b.y), MAX(a.x, b.x),
+                     MAX(a.y, b.y)};
+  lv_area_move(&dirty, view->coords.x1, view->coords.y1);
+  lv_obj_invalidate_area(view, &dirty);
+}
+
+void draw_background(lv_obj_t *canvas, const struct draw_dscs *dscs) {
   lv_canvas_draw_rect(canvas, 0, 0, CANVAS_WIDTH, CANVAS_HEIGHT,
-                      &rect_black_dsc);
+                      &dscs->rect_bg);
 }
 
+void draw_chrome(lv_obj_t *canvas, lv_color_t cbuf[], struct chrome_layer *chrome,
+                 const struct draw_dscs *dscs, draw_chrome_cb draw,
+                 const lv_area_t *area) {
+  // The drawing canvas is hidden, rotate_canvas() invalidates the view
+  if (!chrome->ready) {
+    draw_background(canvas, dscs);
+    if (draw) {
+#if IS_ENABLED(CONFIG_NICE_OLED_DISPLAY_LIST)
+      // Drawn only once, so there is nothing to compare it with
+      static struct display_list list;
+      display_list_reset(&list, canvas);
+      draw(&list, dscs);
+      display_list_replay(&list);
+#else
+      draw(canvas, dscs);
+#endif
+    }
+    memcpy(chrome->buf, cbuf, sizeof(chrome->buf));
+    chrome->ready = true;
+    return;
+  }
+
+  if (area == NULL) {
+    memcpy(cbuf, chrome->buf, sizeof(chrome->buf));
+    return;
+  }
+
+  lv_area_t clip;
+  const lv_area_t full = {0, 0, CANVAS_WIDTH - 1, CANVAS_HEIGHT - 1};
+  if (!_lv_area_intersect(&clip, area, &full)) {
+    return;
+  }
+
+  for (int y = clip.y1; y <= clip.y2; y++) {
+    memcpy(&cbuf[y * CANVAS_WIDTH + clip.x1],
+           &chrome->buf[y * CANVAS_WIDTH + clip.x1],
+           lv_area_get_width(&clip) * sizeof(lv_color_t));
+  }
+}
+#endif
+
+// Set the pixels of a packed 1bpp (MSB first) bitmap to `color`, clipped to
+// `max_w` columns like lv_canvas_draw_text() clips its label.
+void canvas_draw_bits(lv_obj_t *canvas, lv_coord_t x, lv_coord_t y,
+                      lv_coord_t max_w, const uint8_t *bits, lv_coord_t stride,
+                      lv_coord_t w, lv_coord_t h, lv_color_t color) {
+  lv_img_dsc_t *img = lv_canvas_get_img(canvas);
+  lv_color_t *cbuf = (lv_color_t *)img->data;
+  lv_coord_t canvas_w = img->header.w;
+
+  lv_coord_t x1 = MAX(x, 0);
+  lv_coord_t x2 = MIN(x + MIN(w, max_w) - 1, canvas_w - 1);
+  lv_coord_t y1 = MAX(y, 0);
+  lv_coord_t y2 = MIN(y + h - 1, (lv_coord_t)img->header.h - 1);
+
+  for (lv_coord_t py = y1; py <= y2; py++) {
+    const uint8_t *row = &bits[(py - y) * stride];
+    for (lv_coord_t px = x1; px <= x2; px++) {
+      lv_coord_t bx = px - x;
+      if (row[bx >> 3] & (0x80 >> (bx & 7))) {
+        cbuf[py * canvas_w + px] = color;
+      }
+    }
+  }
+
+  if (x1 <= x2 && y1 <= y2) {
+    lv_area_t area = {x1, y1, x2, y2};
+    lv_obj_invalidate_area(canvas, &area);
+  }
+}
+
+#if !IS_ENABLED(CONFIG_NICE_OLED_ENGINE_DIRECT)
+// Overwrite a w x h area of the drawing canvas with a packed 1bpp bitmap, set
+// pixels in the foreground color, and rotate only that area into the view.
+void canvas_patch_bits(lv_obj_t *canvas, lv_coord_t x, lv_coord_t y,
+                       const uint8_t *bits, lv_coord_t stride, lv_coord_t w,
+                       lv_coord_t h) {
+  lv_color_t *cbuf = (lv_color_t *)lv_canvas_get_img(canvas)->data;
+  lv_area_t area = {x, y, x + w - 1, y + h - 1};
+  const lv_area_t full = {0, 0, CANVAS_WIDTH - 1, CANVAS_HEIGHT - 1};
+  if (!_lv_area_intersect(&area, &area, &full)) {
+    return;
+  }
+
+  for (lv_coord_t py = area.y1; py <= area.y2; py++) {
+    const uint8_t *row = &bits[(py - y) * stride];
+    for (lv_coord_t px = area.x1; px <= area.x2; px++) {
+      lv_coord_t bx = px - x;
+      bool set = row[bx >> 3] & (0x80 >> (bx & 7));
+      cbuf[py * CANVAS_WIDTH + px] = set ? LVGL_FOREGROUND : LVGL_BACKGROUND;
+    }
+  }
+
+  lv_obj_t *view = lv_obj_get_child(lv_obj_get_parent(canvas), CANVAS_VIEW_CHILD);
+  rotate_canvas(view, cbuf, &area);
+}
+#endif
+
 void init_label_dsc(lv_draw_label_dsc_t *label_dsc, lv_color_t color,
                     const lv_font_t *font, lv_text_align_t align) {
   lv_draw_label_dsc_init(label_dsc);
@@ -50,3 +211,17 @@ void init_line_dsc(lv_draw_line_dsc_t *line_dsc, lv_color_t color,
   line_dsc->color = color;
   line_dsc->width = width;
 }
+
+void init_draw_dscs(struct draw_dscs *dscs) {
+  lv_draw_img_dsc_init(&dscs->img);
+  init_rect_dsc(&dscs->rect_fg, LVGL_FOREGROUND);
+  init_rect_dsc(&dscs->rect_bg, LVGL_BACKGROUND);
+  init_line_dsc(&dscs->line_thin, LVGL_FOREGROUND, 1);
+  init_line_dsc(&dscs->line_thick, LVGL_FOREGROUND, 2);
+  init_label_dsc(&dscs->label, LVGL_FOREGROUND, &pixel_operator_mono,
+                 LV_TEXT_ALIGN_LEFT);
+  init_label_dsc(&dscs->label_small, LVGL_FOREGROUND, &pixel_operator_mono_8,
+                 LV_TEXT_ALIGN_LEFT);
+  init_label_dsc(&dscs->label_wpm, LVGL_FOREGROUND, &pixel_operator_mono_12,
+                 LV_TEXT_ALIGN_LEFT);
+}
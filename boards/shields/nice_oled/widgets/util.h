@@ -1,7 +1,11 @@
 #pragma once
 
 #include <lvgl.h>
+#include "draw.h"
 #include <zmk/endpoints.h>
+#if !IS_ENABLED(CONFIG_ZMK_SPLIT) || IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL)
+#include "wpm_history.h"
+#endif
 
 #define CANVAS_WIDTH 68
 #define CANVAS_HEIGHT 160
@@ -23,18 +27,68 @@ struct status_state {
   bool active_profile_bonded;
   uint8_t layer_index;
   const char *layer_label;
-  uint8_t wpm[10];
+  struct wpm_history wpm;
   uint8_t mod_state;
 #else
   bool connected;
 #endif
 };
 
+/*
+ * Static pixels (background, fixed images) of the CANVAS_WIDTH x CANVAS_HEIGHT
+ * drawing area, rendered once and copied back at the start of every redraw.
+ */
+struct chrome_layer {
+  bool ready;
+  lv_color_t buf[CANVAS_WIDTH * CANVAS_HEIGHT];
+};
+
+/*
+ * Draw descriptors shared by all widgets of a screen. They never change after
+ * init_draw_dscs(), so redraws skip the lv_draw_*_dsc_init() calls.
+ */
+struct draw_dscs {
+  lv_draw_img_dsc_t img;
+  lv_draw_rect_dsc_t rect_fg;
+  lv_draw_rect_dsc_t rect_bg;
+  lv_draw_line_dsc_t line_thin;
+  lv_draw_line_dsc_t line_thick;
+  lv_draw_label_dsc_t label;       // pixel_operator_mono
+  lv_draw_label_dsc_t label_small; // pixel_operator_mono_8
+  lv_draw_label_dsc_t label_wpm;   // pixel_operator_mono_12
+};
+
+typedef void (*draw_chrome_cb)(draw_target_t *canvas, const struct draw_dscs *dscs);
+
 void to_uppercase(char *str);
-void rotate_canvas(lv_obj_t *canvas, lv_color_t cbuf[]);
-void draw_background(lv_obj_t *canvas);
+lv_point_t rotation_pivot(int16_t angle);
+lv_point_t rotation_map(int16_t angle, lv_point_t pivot, lv_coord_t x,
+                        lv_coord_t y);
+#if !IS_ENABLED(CONFIG_NICE_OLED_ENGINE_DIRECT)
+/*
+ * Widgets draw into a hidden CANVAS_WIDTH x CANVAS_HEIGHT canvas backed by
+ * `cbuf`. rotate_canvas() maps the pixels of an area of it through the panel
+ * rotation into the view, the landscape canvas LVGL shows, and invalidates
+ * only where they landed.
+ */
+#define CANVAS_VIEW_CHILD 0
+#define CANVAS_DRAW_CHILD 1
+void canvas_create(lv_obj_t *parent, lv_color_t view_buf[], lv_color_t cbuf[]);
+// `area` NULL rotates the whole drawing area
+void rotate_canvas(lv_obj_t *view, const lv_color_t cbuf[],
+                   const lv_area_t *area);
+void draw_background(lv_obj_t *canvas, const struct draw_dscs *dscs);
+// Restore the chrome layer into the drawing canvas, everywhere or only in `area`
+void draw_chrome(lv_obj_t *canvas, lv_color_t cbuf[], struct chrome_layer *chrome,
+                 const struct draw_dscs *dscs, draw_chrome_cb draw,
+                 const lv_area_t *area);
+#endif
+void canvas_draw_bits(lv_obj_t *canvas, lv_coord_t x, lv_coord_t y,
+                      lv_coord_t max_w, const uint8_t *bits, lv_coord_t stride,
+                      lv_coord_t w, lv_coord_t h, lv_color_t color);
 void init_rect_dsc(lv_draw_rect_dsc_t *rect_dsc, lv_color_t bg_color);
 void init_line_dsc(lv_draw_line_dsc_t *line_dsc, lv_color_t color,
                    uint8_t width);
 void init_label_dsc(lv_draw_label_dsc_t *label_dsc, lv_color_t color,
                     const lv_font_t *font, lv_text_align_t align);
+void init_draw_dscs(struct draw_dscs *dscs);
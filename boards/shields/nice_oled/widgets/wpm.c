@@ -1,36 +1,29 @@
 #include "wpm.h"
 #include "../assets/custom_fonts.h"
+#include "wpm_graph.h"
 #include <math.h>
 #include <zephyr/kernel.h>
 
 LV_IMG_DECLARE(gauge);
 LV_IMG_DECLARE(grid);
 
-static void draw_gauge(lv_obj_t *canvas, const struct status_state *state) {
-    lv_draw_img_dsc_t img_dsc;
-    lv_draw_img_dsc_init(&img_dsc);
-
-    lv_canvas_draw_img(canvas, 0, 70, &gauge, &img_dsc);
+#if IS_ENABLED(CONFIG_NICE_OLED_WIDGET_WPM_METER)
+// Positions are relative to LAYOUT_WPM
+static void draw_gauge(draw_target_t *canvas, const lv_area_t *area,
+                       const struct draw_dscs *dscs) {
+    draw_img(canvas, area->x1 + WPM_GAUGE_X, area->y1 + WPM_GAUGE_Y, &gauge, &dscs->img);
 }
 
-static void draw_needle(lv_obj_t *canvas, const struct status_state *state) {
-    lv_draw_line_dsc_t line_dsc;
-    init_line_dsc(&line_dsc, LVGL_FOREGROUND, 1);
-
+void wpm_needle_points(const struct status_state *state, lv_point_t points[2]) {
     int centerX = 12; // 16 default
-    int centerY = 90; // 100 gut, 66 default
+    int centerY = 26; // 100 gut, 66 default
     int offset = 5;   // 5 def, largo de la aguja
-    int value = state->wpm[9];
+    int value = wpm_history_latest(&state->wpm);
 
 #if IS_ENABLED(CONFIG_NICE_OLED_GEM_ANIMATION_WPM_FIXED_RANGE)
     float max = CONFIG_NICE_OLED_GEM_ANIMATION_WPM_FIXED_RANGE_MAX;
 #else
-    float max = 0;
-    for (int i = 0; i < 10; i++) {
-        if (state->wpm[i] > max) {
-            max = state->wpm[i];
-        }
-    }
+    float max = wpm_history_max(&state->wpm);
 #endif
     if (max == 0)
         max = 100;
@@ -56,108 +49,107 @@ static void draw_needle(lv_obj_t *canvas, const struct status_state *state) {
     int needleEndX = centerX + (int)(radius * cos(angleRad));
     int needleEndY = centerY + (int)(radius * sin(angleRad));
 
-    lv_point_t points[2] = {{needleStartX, needleStartY}, {needleEndX, needleEndY}};
-    // canvas, points, number of points, line_dsc
-    lv_canvas_draw_line(canvas, points, 2, &line_dsc);
-    // lv_canvas_draw_line(canvas, points, 2, &line_dsc);
+    points[0] = (lv_point_t){needleStartX, needleStartY};
+    points[1] = (lv_point_t){needleEndX, needleEndY};
 }
 
-#if IS_ENABLED(CONFIG_NICE_OLED_WIDGET_WPM_LUNA)
-#else
-static void draw_grid(lv_obj_t *canvas) {
-    lv_draw_img_dsc_t img_dsc;
-    lv_draw_img_dsc_init(&img_dsc);
+static void draw_needle(draw_target_t *canvas, const lv_area_t *area,
+                        const struct draw_dscs *dscs, const struct status_state *state) {
+    lv_point_t points[2];
 
-    lv_canvas_draw_img(canvas, -1, 95, &grid, &img_dsc);
+    wpm_needle_points(state, points);
+    for (int i = 0; i < 2; i++) {
+        points[i].x += area->x1;
+        points[i].y += area->y1;
+    }
+    draw_line(canvas, points, 2, &dscs->line_thin);
 }
 
-static void draw_graph(lv_obj_t *canvas, const struct status_state *state) {
-    lv_draw_line_dsc_t line_dsc;
-    init_line_dsc(&line_dsc, LVGL_FOREGROUND, 2);
-    lv_point_t points[10];
+static void draw_grid(draw_target_t *canvas, const lv_area_t *area,
+                      const struct draw_dscs *dscs) {
+    draw_img(canvas, area->x1 + WPM_GRID_X, area->y1 + WPM_GRID_Y, &grid, &dscs->img);
+}
 
 #if IS_ENABLED(CONFIG_NICE_OLED_GEM_ANIMATION_WPM_FIXED_RANGE)
-    int max = CONFIG_NICE_OLED_GEM_ANIMATION_WPM_FIXED_RANGE_MAX;
-    if (max == 0) {
-        max = 100;
-    }
-
-    int value = 0;
-    for (int i = 0; i < 10; i++) {
-        value = state->wpm[i];
-        if (value > max) {
-            value = max;
-        }
-
-        // modificar aqui par la posicion de la grafica
-        points[i].x = -36 + i * 7.4;
-        points[i].y = 127 - (value * 32 / max);
-        // points[i].y = 132 - (value * 32 / max);
-    }
+#define GRAPH_X -36
+#define GRAPH_Y 31
 #else
-    int max = 0;
-    int min = 256;
-
-    for (int i = 0; i < 10; i++) {
-        if (state->wpm[i] > max) {
-            max = state->wpm[i];
-        }
-        if (state->wpm[i] < min) {
-            min = state->wpm[i];
-        }
-    }
+#define GRAPH_X 0
+#define GRAPH_Y 1
+#endif
+
+static struct wpm_graph graph;
 
-    int range = max - min;
+const lv_img_dsc_t *wpm_graph_img(const struct wpm_history *history, int width, lv_point_t *pos) {
+#if IS_ENABLED(CONFIG_NICE_OLED_GEM_ANIMATION_WPM_FIXED_RANGE)
+    int min = 0;
+    int range = CONFIG_NICE_OLED_GEM_ANIMATION_WPM_FIXED_RANGE_MAX;
+#else
+    int min = wpm_history_min(history);
+    int range = wpm_history_max(history) - min;
+#endif
     if (range == 0) {
-        range = 1;
+        range = IS_ENABLED(CONFIG_NICE_OLED_GEM_ANIMATION_WPM_FIXED_RANGE) ? 100 : 1;
     }
 
-    for (int i = 0; i < 10; i++) {
-        points[i].x = 0 + i * 7.4;
-        points[i].y = 97 - (state->wpm[i] - min) * 32 / range;
+    // Zeroed until first use
+    if (graph.imgs[0].data == NULL) {
+        wpm_graph_init(&graph, lv_color_to32(LVGL_FOREGROUND));
     }
-#endif
 
-    lv_canvas_draw_line(canvas, points, 10, &line_dsc);
+    *pos = (lv_point_t){GRAPH_X - WPM_GRAPH_PAD, GRAPH_Y - WPM_GRAPH_PAD};
+    return wpm_graph_update(&graph, history, min, range, width);
+}
+
+static void draw_graph(draw_target_t *canvas, const lv_area_t *area,
+                       const struct draw_dscs *dscs, const struct status_state *state) {
+    lv_point_t pos;
+    const lv_img_dsc_t *img = wpm_graph_img(&state->wpm, dscs->line_thick.width, &pos);
+    draw_img(canvas, area->x1 + pos.x, area->y1 + pos.y, img, &dscs->img);
 }
 #endif
 
-static void draw_label(lv_obj_t *canvas, const struct status_state *state) {
-    lv_draw_label_dsc_t label_dsc_wpm;
-    init_label_dsc(&label_dsc_wpm, LVGL_FOREGROUND, &pixel_operator_mono_12, LV_TEXT_ALIGN_LEFT);
+lv_coord_t wpm_label_x(uint8_t wpm) {
+    // if wpm < 10, elsse if wpm => 10 and wpm < 100, else wpm >= 100
+    if (wpm < 10) {
+        return 12;
+    } else if (wpm < 100) {
+        return 9;
+    }
+    return 7;
+}
+
+static void draw_wpm_label(draw_target_t *canvas, const lv_area_t *area,
+                           const struct draw_dscs *dscs, const struct status_state *state) {
     // init_label_dsc(&label_dsc_wpm, LVGL_FOREGROUND, &pixel_operator_mono,
     // LV_TEXT_ALIGN_LEFT);
 
     char wpm_text[10] = {};
+    uint8_t wpm = wpm_history_latest(&state->wpm);
 
-    snprintf(wpm_text, sizeof(wpm_text), "%d", state->wpm[9]);
-    // if wpm < 10, elsse if wpm => 10 and wpm < 100, else wpm >= 100
-    if (state->wpm[9] < 10) {
-        lv_canvas_draw_text(canvas, 12, 75, 50, &label_dsc_wpm, wpm_text);
-        // lv_canvas_draw_text(canvas, 12, 75, 50, &label_dsc_wpm, wpm_text); //
-        // with global font
-    } else if (state->wpm[9] >= 10 && state->wpm[9] < 100) {
-        lv_canvas_draw_text(canvas, 9, 75, 50, &label_dsc_wpm, wpm_text);
-        // lv_canvas_draw_text(canvas, 8, 75, 50, &label_dsc_wpm, wpm_text); // with
-        // global font
-    } else {
-        lv_canvas_draw_text(canvas, 7, 75, 50, &label_dsc_wpm, wpm_text);
-        // lv_canvas_draw_text(canvas, 5, 75, 50, &label_dsc_wpm, wpm_text); // with
-        // global font
-    }
+    snprintf(wpm_text, sizeof(wpm_text), "%d", wpm);
+    draw_text(canvas, area->x1 + wpm_label_x(wpm), area->y1 + WPM_LABEL_Y, 50, &dscs->label_wpm,
+              wpm_text);
+}
+
+void draw_wpm_chrome(draw_target_t *canvas, const lv_area_t *area,
+                     const struct draw_dscs *dscs) {
+    #if IS_ENABLED(CONFIG_NICE_OLED_WIDGET_WPM_METER)
+        draw_gauge(canvas, area, dscs);
+        draw_grid(canvas, area, dscs);
+    #endif
 }
 
-void draw_wpm_status(lv_obj_t *canvas, const struct status_state *state) {
-    #if IS_ENABLED(CONFIG_NICE_OLED_WIDGET_WPM) && IS_ENABLED(CONFIG_NICE_OLED_WIDGET_WPM_LUNA)
+void draw_wpm_status(draw_target_t *canvas, const lv_area_t *area,
+                     const struct draw_dscs *dscs, const struct status_state *state) {
+    #if IS_ENABLED(CONFIG_NICE_OLED_WIDGET_WPM_METER)
+        // Needle and graph, gauge and grid are chrome
+        draw_needle(canvas, area, dscs, state);
+        draw_graph(canvas, area, dscs, state);
+        draw_wpm_label(canvas, area, dscs, state);
+    #elif IS_ENABLED(CONFIG_NICE_OLED_WIDGET_WPM) && IS_ENABLED(CONFIG_NICE_OLED_WIDGET_WPM_LUNA)
         // Show Luna only – skip everything else
-        draw_label(canvas, state);
-    #elif IS_ENABLED(CONFIG_NICE_OLED_WIDGET_WPM)
-        // Show gauge/needle/graph if Luna isn't enabled
-        draw_gauge(canvas, state);
-        draw_needle(canvas, state);
-        draw_grid(canvas);
-        draw_graph(canvas, state);
-        draw_label(canvas, state);
+        draw_wpm_label(canvas, area, dscs, state);
     #else
         // No WPM at all
     #endif
@@ -7,4 +7,23 @@ struct wpm_status_state {
     uint8_t wpm;
 };
 
-void draw_wpm_status(lv_obj_t *canvas, const struct status_state *state);
\ No newline at end of file
+// Gauge and grid, drawn once into the chrome layer
+void draw_wpm_chrome(draw_target_t *canvas, const lv_area_t *area, const struct draw_dscs *dscs);
+void draw_wpm_status(draw_target_t *canvas, const lv_area_t *area, const struct draw_dscs *dscs,
+                     const struct status_state *state);
+
+// Parts of the meter relative to LAYOUT_WPM, shared with the objects renderer
+#define WPM_GAUGE_X 0
+#define WPM_GAUGE_Y 6
+#define WPM_GRID_X -1
+#define WPM_GRID_Y 31
+#define WPM_LABEL_Y 11
+
+// The number moves left as it gains digits
+lv_coord_t wpm_label_x(uint8_t wpm);
+
+#if IS_ENABLED(CONFIG_NICE_OLED_WIDGET_WPM_METER)
+void wpm_needle_points(const struct status_state *state, lv_point_t points[2]);
+// Brings the graph up to date and returns its image, placed at `pos`
+const lv_img_dsc_t *wpm_graph_img(const struct wpm_history *history, int width, lv_point_t *pos);
+#endif
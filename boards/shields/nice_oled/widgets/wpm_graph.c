@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "bitmap.h"
+#include "wpm_graph.h"
+
+void wpm_graph_init(struct wpm_graph *graph, uint32_t foreground) {
+    const uint32_t palette[2] = {
+        0, // transparent, whatever is behind shows through
+        foreground | 0xFF000000,
+    };
+
+    for (int i = 0; i < 2; i++) {
+        memcpy(graph->bufs[i], palette, sizeof(palette));
+
+        lv_img_dsc_t *img = &graph->imgs[i];
+        img->header.cf = LV_IMG_CF_INDEXED_1BIT;
+        img->header.w = WPM_GRAPH_W;
+        img->header.h = WPM_GRAPH_H;
+        img->data_size = sizeof(graph->bufs[i]);
+        img->data = graph->bufs[i];
+    }
+    graph->current = 0;
+    graph->valid = false;
+}
+
+static lv_point_t graph_point(const struct wpm_graph *graph, int i, int value) {
+    value = CLAMP(value - graph->min, 0, graph->range);
+    return (lv_point_t){
+        .x = WPM_GRAPH_PAD + i * WPM_GRAPH_STEP,
+        .y = WPM_GRAPH_PAD + WPM_GRAPH_SPAN - value * WPM_GRAPH_SPAN / graph->range,
+    };
+}
+
+// Bresenham with a square pen of `width` pixels
+static void graph_segment(uint8_t *bits, lv_point_t a, lv_point_t b, int width) {
+    int dx = abs(b.x - a.x), sx = a.x < b.x ? 1 : -1;
+    int dy = -abs(b.y - a.y), sy = a.y < b.y ? 1 : -1;
+    int err = dx + dy;
+
+    for (;;) {
+        bitmap_fill(bits, WPM_GRAPH_STRIDE, a.x - width / 2, a.y - width / 2, width, width, true);
+        if (a.x == b.x && a.y == b.y) {
+            break;
+        }
+        int e2 = 2 * err;
+        if (e2 >= dy) {
+            err += dy;
+            a.x += sx;
+        }
+        if (e2 <= dx) {
+            err += dx;
+            a.y += sy;
+        }
+    }
+}
+
+static void graph_draw(const struct wpm_graph *graph, uint8_t *bits,
+                       const struct wpm_history *history, int i, int width) {
+    graph_segment(bits, graph_point(graph, i, wpm_history_at(history, i)),
+                  graph_point(graph, i + 1, wpm_history_at(history, i + 1)), width);
+}
+
+const lv_img_dsc_t *wpm_graph_update(struct wpm_graph *graph, const struct wpm_history *history,
+                                     int min, int range, int width) {
+    bool rescaled = !graph->valid || min != graph->min || range != graph->range;
+    if (!rescaled && history->seq == graph->seq) {
+        return &graph->imgs[graph->current];
+    }
+    bool scrolled = !rescaled && history->seq == graph->seq + 1;
+
+    graph->min = min;
+    graph->range = range;
+    width = CLAMP(width, 1, 2 * WPM_GRAPH_PAD + 1);
+
+    const uint8_t *prev = &graph->bufs[graph->current][WPM_GRAPH_PALETTE];
+    graph->current ^= 1;
+    uint8_t *bits = &graph->bufs[graph->current][WPM_GRAPH_PALETTE];
+    bitmap_fill(bits, WPM_GRAPH_STRIDE, 0, 0, WPM_GRAPH_W, WPM_GRAPH_H, false);
+
+    if (scrolled) {
+        bitmap_blit(bits, WPM_GRAPH_STRIDE, 0, 0, prev, WPM_GRAPH_STRIDE, WPM_GRAPH_STEP, 0,
+                    WPM_GRAPH_W - WPM_GRAPH_STEP, WPM_GRAPH_H, BITMAP_COPY);
+
+        /*
+         * The dropped segment left pen pixels up to a pen's width right of
+         * point 0. Clear everything left of point 1 and at least that far,
+         * then redraw the segments the cleared columns cut into.
+         */
+        int clear = MAX(graph_point(graph, 1, 0).x, 2 * WPM_GRAPH_PAD + 1);
+        bitmap_fill(bits, WPM_GRAPH_STRIDE, 0, 0, clear, WPM_GRAPH_H, false);
+        for (int i = 0; i < WPM_GRAPH_POINTS - 2 && i * WPM_GRAPH_STEP < clear; i++) {
+            graph_draw(graph, bits, history, i, width);
+        }
+        graph_draw(graph, bits, history, WPM_GRAPH_POINTS - 2, width);
+    } else {
+        for (int i = 0; i < WPM_GRAPH_POINTS - 1; i++) {
+            graph_draw(graph, bits, history, i, width);
+        }
+    }
+
+    graph->seq = history->seq;
+    graph->valid = true;
+    return &graph->imgs[graph->current];
+}
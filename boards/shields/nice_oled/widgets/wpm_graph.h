@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <lvgl.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/toolchain.h>
+
+#include "wpm_history.h"
+
+/*
+ * The WPM history plotted into a 1 bit image. The graph scrolls: when the
+ * history moved on by one sample, the previous image is copied one step to
+ * the left and only the ends are redrawn. It is replotted when the scale
+ * changes. The two buffers alternate, so a changed graph is always a
+ * different image.
+ */
+#define WPM_GRAPH_POINTS WPM_HISTORY_LEN
+#define WPM_GRAPH_STEP MAX(1, 63 / (WPM_GRAPH_POINTS - 1))
+#define WPM_GRAPH_SPAN 32
+// Room for the pen around the plotted points
+#define WPM_GRAPH_PAD 1
+#define WPM_GRAPH_W ((WPM_GRAPH_POINTS - 1) * WPM_GRAPH_STEP + 2 * WPM_GRAPH_PAD + 1)
+#define WPM_GRAPH_H (WPM_GRAPH_SPAN + 2 * WPM_GRAPH_PAD + 1)
+#define WPM_GRAPH_STRIDE DIV_ROUND_UP(WPM_GRAPH_W, 8)
+// ARGB8888 palette in front of the pixels, index 0 then 1
+#define WPM_GRAPH_PALETTE (2 * sizeof(uint32_t))
+
+struct wpm_graph {
+    lv_img_dsc_t imgs[2];
+    uint8_t bufs[2][WPM_GRAPH_PALETTE + WPM_GRAPH_STRIDE * WPM_GRAPH_H] __aligned(4);
+    uint8_t current;
+    bool valid;
+    uint32_t seq;
+    int min;
+    int range;
+};
+
+// Set up both images with a transparent background and an opaque `foreground`.
+void wpm_graph_init(struct wpm_graph *graph, uint32_t foreground);
+
+/*
+ * Bring the graph up to date with `history`, values min..min + range spanning
+ * its height, drawn with a square pen of `width` pixels (1 to 3). Returns the
+ * current image.
+ */
+const lv_img_dsc_t *wpm_graph_update(struct wpm_graph *graph, const struct wpm_history *history,
+                                     int min, int range, int width);
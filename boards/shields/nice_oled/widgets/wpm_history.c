@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "wpm_history.h"
+
+static inline uint8_t sample(const struct wpm_history *history, uint32_t seq) {
+    return history->samples[seq % WPM_HISTORY_LEN];
+}
+
+static inline uint32_t back(const struct wpm_deque *deque) {
+    return deque->seq[(deque->head + deque->len - 1) % WPM_HISTORY_LEN];
+}
+
+/*
+ * Drop the sample that left the window, then every sample the new one makes
+ * irrelevant: for the minimum those not below it, for the maximum those not
+ * above it.
+ */
+static void deque_push(struct wpm_history *history, struct wpm_deque *deque, bool is_max) {
+    uint32_t seq = history->seq;
+    uint8_t wpm = sample(history, seq);
+
+    if (deque->len > 0 && seq - deque->seq[deque->head] >= WPM_HISTORY_LEN) {
+        deque->head = (deque->head + 1) % WPM_HISTORY_LEN;
+        deque->len--;
+    }
+
+    while (deque->len > 0) {
+        uint8_t last = sample(history, back(deque));
+        if (is_max ? last > wpm : last < wpm) {
+            break;
+        }
+        deque->len--;
+    }
+
+    deque->seq[(deque->head + deque->len) % WPM_HISTORY_LEN] = seq;
+    deque->len++;
+}
+
+void wpm_history_init(struct wpm_history *history) {
+    memset(history, 0, sizeof(*history));
+    // Sample 0 stands for the whole zeroed window
+    history->min.len = 1;
+    history->max.len = 1;
+}
+
+void wpm_history_push(struct wpm_history *history, uint8_t wpm) {
+    history->seq++;
+    history->samples[history->seq % WPM_HISTORY_LEN] = wpm;
+    deque_push(history, &history->min, false);
+    deque_push(history, &history->max, true);
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#define WPM_HISTORY_LEN CONFIG_NICE_OLED_WPM_HISTORY
+
+/*
+ * The last WPM_HISTORY_LEN samples of ZMK's WPM in a ring buffer. Minimum and
+ * maximum of the window are tracked with two monotonic deques, so a new
+ * sample costs amortized O(1) and nothing ever rescans the history.
+ *
+ * Samples are numbered by `seq`; the deques hold the numbers of the samples
+ * that can still become the minimum or maximum, oldest first.
+ */
+struct wpm_deque {
+    uint32_t seq[WPM_HISTORY_LEN];
+    uint8_t head;
+    uint8_t len;
+};
+
+struct wpm_history {
+    uint8_t samples[WPM_HISTORY_LEN];
+    // Number of the newest sample; it is stored at samples[seq % WPM_HISTORY_LEN]
+    uint32_t seq;
+    struct wpm_deque min;
+    struct wpm_deque max;
+};
+
+// Start with a window full of zeros, like ZMK reports before the first key.
+void wpm_history_init(struct wpm_history *history);
+void wpm_history_push(struct wpm_history *history, uint8_t wpm);
+
+// Sample i of the window, 0 being the oldest.
+static inline uint8_t wpm_history_at(const struct wpm_history *history, int i) {
+    return history->samples[(history->seq + 1 + i) % WPM_HISTORY_LEN];
+}
+
+static inline uint8_t wpm_history_latest(const struct wpm_history *history) {
+    return history->samples[history->seq % WPM_HISTORY_LEN];
+}
+
+static inline uint8_t wpm_history_min(const struct wpm_history *history) {
+    return history->samples[history->min.seq[history->min.head] % WPM_HISTORY_LEN];
+}
+
+static inline uint8_t wpm_history_max(const struct wpm_history *history) {
+    return history->samples[history->max.seq[history->max.head] % WPM_HISTORY_LEN];
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdio.h>
+#include <time.h>
+
+#include "bitmap.h"
+#include "reference.h"
+
+/*
+ * Times each kernel against its per-pixel reference on the sizes the direct
+ * engine works with: the 160x68 nice!view frame and a 34x34 Luna sprite at an
+ * unaligned position. Host timings only show the ratio between the two; the
+ * cost on the keyboard has to be measured there.
+ */
+
+#define FB_W 160
+#define FB_H 68
+#define FB_STRIDE (FB_W / 8)
+#define SPRITE 34
+#define SPRITE_STRIDE ((SPRITE + 7) / 8)
+
+static uint8_t fb[FB_STRIDE * FB_H];
+static uint8_t sprite[SPRITE_STRIDE * SPRITE];
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Nanoseconds per call, averaged over enough calls to take about 100 ms
+static double time_ns(void (*fn)(void)) {
+    int calls = 1;
+    for (;;) {
+        double start = now_ns();
+        for (int i = 0; i < calls; i++) {
+            fn();
+        }
+        double elapsed = now_ns() - start;
+        if (elapsed > 1e8) {
+            return elapsed / calls;
+        }
+        calls *= 2;
+    }
+}
+
+static void fill_kernel(void) { bitmap_fill(fb, FB_STRIDE, 0, 0, FB_W, FB_H, false); }
+static void fill_ref(void) { ref_fill(fb, FB_STRIDE, 0, 0, FB_W, FB_H, false); }
+
+static void blit_kernel(void) {
+    bitmap_blit(fb, FB_STRIDE, 61, 17, sprite, SPRITE_STRIDE, 0, 0, SPRITE, SPRITE, BITMAP_OR);
+}
+static void blit_ref(void) {
+    ref_blit(fb, FB_STRIDE, 61, 17, sprite, SPRITE_STRIDE, 0, 0, SPRITE, SPRITE, BITMAP_OR);
+}
+
+static void frame_kernel(void) {
+    bitmap_blit(fb, FB_STRIDE, 0, FB_H / 2, fb, FB_STRIDE, 0, 0, FB_W, FB_H / 2, BITMAP_COPY);
+}
+static void frame_ref(void) {
+    ref_blit(fb, FB_STRIDE, 0, FB_H / 2, fb, FB_STRIDE, 0, 0, FB_W, FB_H / 2, BITMAP_COPY);
+}
+
+static const struct {
+    const char *name;
+    void (*kernel)(void);
+    void (*ref)(void);
+} cases[] = {
+    {"fill 160x68 frame", fill_kernel, fill_ref},
+    {"blit 34x34 sprite at (61, 17), or", blit_kernel, blit_ref},
+    {"blit 160x34 half frame, copy", frame_kernel, frame_ref},
+};
+
+int main(void) {
+    ref_random_fill(fb, sizeof(fb));
+    ref_random_fill(sprite, sizeof(sprite));
+
+    printf("%-36s %12s %12s %8s\n", "case", "kernel ns", "per-pixel ns", "speedup");
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        double kernel = time_ns(cases[i].kernel);
+        double ref = time_ns(cases[i].ref);
+        printf("%-36s %12.0f %12.0f %7.1fx\n", cases[i].name, kernel, ref, ref / kernel);
+    }
+    return 0;
+}
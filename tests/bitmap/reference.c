@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "reference.h"
+
+bool ref_get(const uint8_t *bits, size_t stride, int x, int y) {
+    return bits[y * stride + x / 8] & (0x80 >> (x % 8));
+}
+
+void ref_set(uint8_t *bits, size_t stride, int x, int y, bool set) {
+    uint8_t mask = 0x80 >> (x % 8);
+
+    if (set) {
+        bits[y * stride + x / 8] |= mask;
+    } else {
+        bits[y * stride + x / 8] &= ~mask;
+    }
+}
+
+void ref_fill(uint8_t *dst, size_t stride, int x, int y, int w, int h, bool set) {
+    for (int row = y; row < y + h; row++) {
+        for (int col = x; col < x + w; col++) {
+            ref_set(dst, stride, col, row, set);
+        }
+    }
+}
+
+void ref_blit(uint8_t *dst, size_t dst_stride, int dx, int dy, const uint8_t *src,
+              size_t src_stride, int sx, int sy, int w, int h, enum bitmap_op op) {
+    for (int row = 0; row < h; row++) {
+        for (int col = 0; col < w; col++) {
+            bool s = ref_get(src, src_stride, sx + col, sy + row);
+            bool d = ref_get(dst, dst_stride, dx + col, dy + row);
+
+            switch (op) {
+            case BITMAP_COPY:
+                d = s;
+                break;
+            case BITMAP_COPY_INV:
+                d = !s;
+                break;
+            case BITMAP_OR:
+                d = d || s;
+                break;
+            case BITMAP_CLEAR:
+                d = d && !s;
+                break;
+            }
+            ref_set(dst, dst_stride, dx + col, dy + row, d);
+        }
+    }
+}
+
+static uint32_t state = 0x2545F491;
+
+uint32_t ref_random(void) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+void ref_random_fill(uint8_t *buf, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = ref_random();
+    }
+}
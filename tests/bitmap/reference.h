@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "bitmap.h"
+
+/*
+ * One pixel at a time versions of the bitmap.h kernels, written for
+ * obviousness rather than speed. The tests compare the kernels against them
+ * and the benchmark uses them as the baseline.
+ */
+
+bool ref_get(const uint8_t *bits, size_t stride, int x, int y);
+void ref_set(uint8_t *bits, size_t stride, int x, int y, bool set);
+
+void ref_fill(uint8_t *dst, size_t stride, int x, int y, int w, int h, bool set);
+void ref_blit(uint8_t *dst, size_t dst_stride, int dx, int dy, const uint8_t *src,
+              size_t src_stride, int sx, int sy, int w, int h, enum bitmap_op op);
+
+// Deterministic xorshift32, so a failure reproduces
+uint32_t ref_random(void);
+void ref_random_fill(uint8_t *buf, size_t len);
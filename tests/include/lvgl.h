@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+/*
+ * The part of LVGL 8.3's API the host-built widgets and fonts use, with the
+ * same field names and meanings at LV_COLOR_DEPTH 1. The functions are
+ * implemented by the test that links them.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define LVGL_VERSION_MAJOR 8
+#define LVGL_VERSION_MINOR 3
+#define LVGL_VERSION_PATCH 0
+#define LV_VERSION_CHECK(x, y, z)                                                                  \
+    (x == LVGL_VERSION_MAJOR &&                                                                    \
+     (y < LVGL_VERSION_MINOR || (y == LVGL_VERSION_MINOR && z <= LVGL_VERSION_PATCH)))
+
+#define LV_ATTRIBUTE_LARGE_CONST
+
+typedef int16_t lv_coord_t;
+typedef uint8_t lv_opa_t;
+
+#define LV_OPA_TRANSP 0
+#define LV_OPA_MAX 253
+#define LV_OPA_COVER 255
+
+typedef struct {
+    lv_coord_t x;
+    lv_coord_t y;
+} lv_point_t;
+
+typedef struct {
+    lv_coord_t x1;
+    lv_coord_t y1;
+    lv_coord_t x2;
+    lv_coord_t y2;
+} lv_area_t;
+
+typedef union {
+    uint8_t full;
+} lv_color_t;
+
+/** ───── Fonts ──────────────────────────────────────────── */
+struct _lv_font_t;
+
+typedef struct {
+    const struct _lv_font_t *resolved_font;
+    uint16_t adv_w;
+    uint16_t box_w;
+    uint16_t box_h;
+    int16_t ofs_x;
+    int16_t ofs_y;
+    uint8_t bpp;
+} lv_font_glyph_dsc_t;
+
+enum {
+    LV_FONT_SUBPX_NONE,
+    LV_FONT_SUBPX_HOR,
+    LV_FONT_SUBPX_VER,
+    LV_FONT_SUBPX_BOTH,
+};
+
+typedef struct _lv_font_t {
+    bool (*get_glyph_dsc)(const struct _lv_font_t *, lv_font_glyph_dsc_t *, uint32_t letter,
+                          uint32_t letter_next);
+    const uint8_t *(*get_glyph_bitmap)(const struct _lv_font_t *, uint32_t);
+    lv_coord_t line_height;
+    lv_coord_t base_line;
+    uint8_t subpx : 2;
+    int8_t underline_position;
+    int8_t underline_thickness;
+    const void *dsc;
+    const struct _lv_font_t *fallback;
+    void *user_data;
+} lv_font_t;
+
+#define LV_FONT_DECLARE(font_name) extern const lv_font_t font_name;
+
+typedef struct {
+    uint32_t bitmap_index : 20;
+    uint32_t adv_w : 12;
+    uint8_t box_w;
+    uint8_t box_h;
+    int8_t ofs_x;
+    int8_t ofs_y;
+} lv_font_fmt_txt_glyph_dsc_t;
+
+enum {
+    LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL,
+    LV_FONT_FMT_TXT_CMAP_SPARSE_FULL,
+    LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY,
+    LV_FONT_FMT_TXT_CMAP_SPARSE_TINY,
+};
+typedef uint8_t lv_font_fmt_txt_cmap_type_t;
+
+typedef struct {
+    uint32_t range_start;
+    uint16_t range_length;
+    uint16_t glyph_id_start;
+    const uint32_t *unicode_list;
+    const void *glyph_id_ofs_list;
+    uint16_t list_length;
+    lv_font_fmt_txt_cmap_type_t type;
+} lv_font_fmt_txt_cmap_t;
+
+typedef struct {
+    uint32_t last_letter;
+    uint32_t last_glyph_id;
+} lv_font_fmt_txt_glyph_cache_t;
+
+enum {
+    LV_FONT_FMT_TXT_PLAIN = 0,
+    LV_FONT_FMT_TXT_COMPRESSED = 1,
+    LV_FONT_FMT_TXT_COMPRESSED_NO_PREFILTER = 1,
+};
+
+typedef struct {
+    const uint8_t *glyph_bitmap;
+    const lv_font_fmt_txt_glyph_dsc_t *glyph_dsc;
+    const lv_font_fmt_txt_cmap_t *cmaps;
+    const void *kern_dsc;
+    uint16_t kern_scale;
+    uint16_t cmap_num : 9;
+    uint16_t bpp : 4;
+    uint16_t kern_classes : 1;
+    uint16_t bitmap_format : 2;
+    lv_font_fmt_txt_glyph_cache_t *cache;
+} lv_font_fmt_txt_dsc_t;
+
+bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t *font, lv_font_glyph_dsc_t *dsc_out,
+                                   uint32_t unicode_letter, uint32_t unicode_letter_next);
+const uint8_t *lv_font_get_bitmap_fmt_txt(const lv_font_t *font, uint32_t letter);
+
+/** ───── Labels ─────────────────────────────────────────── */
+enum {
+    LV_TEXT_ALIGN_AUTO,
+    LV_TEXT_ALIGN_LEFT,
+    LV_TEXT_ALIGN_CENTER,
+    LV_TEXT_ALIGN_RIGHT,
+};
+typedef uint8_t lv_text_align_t;
+
+enum {
+    LV_TEXT_FLAG_NONE = 0x00,
+    LV_TEXT_FLAG_RECOLOR = 0x01,
+    LV_TEXT_FLAG_EXPAND = 0x02,
+    LV_TEXT_FLAG_FIT = 0x04,
+};
+typedef uint8_t lv_text_flag_t;
+
+enum {
+    LV_TEXT_DECOR_NONE = 0x00,
+    LV_TEXT_DECOR_UNDERLINE = 0x01,
+    LV_TEXT_DECOR_STRIKETHROUGH = 0x02,
+};
+typedef uint8_t lv_text_decor_t;
+
+enum {
+    LV_BLEND_MODE_NORMAL,
+    LV_BLEND_MODE_ADDITIVE,
+    LV_BLEND_MODE_SUBTRACTIVE,
+    LV_BLEND_MODE_MULTIPLY,
+    LV_BLEND_MODE_REPLACE,
+};
+typedef uint8_t lv_blend_mode_t;
+
+#define LV_DRAW_LABEL_NO_TXT_SEL (0xFFFF)
+
+typedef struct {
+    const lv_font_t *font;
+    uint32_t sel_start;
+    uint32_t sel_end;
+    lv_color_t color;
+    lv_color_t sel_color;
+    lv_color_t sel_bg_color;
+    lv_coord_t line_space;
+    lv_coord_t letter_space;
+    lv_coord_t ofs_x;
+    lv_coord_t ofs_y;
+    lv_opa_t opa;
+    uint8_t bidi_dir;
+    lv_text_align_t align;
+    lv_text_flag_t flag;
+    lv_text_decor_t decor : 3;
+    lv_blend_mode_t blend_mode : 3;
+} lv_draw_label_dsc_t;
+
+void lv_draw_label_dsc_init(lv_draw_label_dsc_t *dsc);
+
+/** ───── Canvas ─────────────────────────────────────────── */
+enum {
+    LV_IMG_CF_UNKNOWN = 0,
+    LV_IMG_CF_RAW,
+    LV_IMG_CF_RAW_ALPHA,
+    LV_IMG_CF_RAW_CHROMA_KEYED,
+    LV_IMG_CF_TRUE_COLOR,
+    LV_IMG_CF_TRUE_COLOR_ALPHA,
+    LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED,
+    LV_IMG_CF_INDEXED_1BIT,
+};
+typedef uint8_t lv_img_cf_t;
+
+typedef struct {
+    uint32_t cf : 5;
+    uint32_t always_zero : 3;
+    uint32_t reserved : 2;
+    uint32_t w : 11;
+    uint32_t h : 11;
+} lv_img_header_t;
+
+typedef struct {
+    lv_img_header_t header;
+    uint32_t data_size;
+    const uint8_t *data;
+} lv_img_dsc_t;
+
+typedef struct _lv_obj_t lv_obj_t;
+
+lv_img_dsc_t *lv_canvas_get_img(lv_obj_t *canvas);
+void lv_canvas_draw_text(lv_obj_t *canvas, lv_coord_t x, lv_coord_t y, lv_coord_t max_w,
+                         const lv_draw_label_dsc_t *draw_dsc, const char *txt);
+void lv_obj_invalidate_area(const lv_obj_t *obj, const lv_area_t *area);
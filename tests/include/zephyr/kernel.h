@@ -0,0 +1,10 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+// Host-built widgets only use the utility macros Zephyr's kernel.h pulls in
+#include <zephyr/sys/util.h>
@@ -0,0 +1,23 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+// The helpers from Zephyr's sys/util.h the host-built widgets use
+
+#ifndef MIN
+#define MIN(a, b) (((a) < (b)) ? (a) : (b))
+#endif
+
+#ifndef MAX
+#define MAX(a, b) (((a) > (b)) ? (a) : (b))
+#endif
+
+#define CLAMP(val, low, high) (((val) <= (low)) ? (low) : MIN(val, high))
+#define DIV_ROUND_UP(n, d) (((n) + (d)-1) / (d))
+#define ARRAY_SIZE(array) (sizeof(array) / sizeof((array)[0]))
+#define BIT(n) (1UL << (n))
+#define BIT_MASK(n) (BIT(n) - 1UL)
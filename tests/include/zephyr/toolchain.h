@@ -0,0 +1,11 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+// The attribute shorthands from Zephyr's toolchain.h the host-built widgets use
+
+#define __aligned(x) __attribute__((__aligned__(x)))
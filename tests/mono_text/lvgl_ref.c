@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <string.h>
+
+#include "lvgl_ref.h"
+
+/*
+ * The LVGL 8.3 functions the fast path stands in for, reduced to the fonts
+ * the shield ships: plain 1bpp bitmaps, one cmap, no kerning. The glyph
+ * lookup follows lv_font_fmt_txt.c and the drawing follows lv_canvas_draw_text()
+ * -> lv_draw_label() -> lv_draw_sw_letter(): the text box runs from (x, y) to
+ * x + max_w - 1 and the canvas bottom, each glyph is placed at
+ * y + line_height - base_line - box_h - ofs_y, and a set bit paints the
+ * label color. Everything goes through the font's callbacks, as in LVGL.
+ */
+
+static uint32_t glyph_id(const lv_font_fmt_txt_dsc_t *fdsc, uint32_t letter) {
+    for (int i = 0; i < fdsc->cmap_num; i++) {
+        const lv_font_fmt_txt_cmap_t *cmap = &fdsc->cmaps[i];
+        uint32_t rcp = letter - cmap->range_start;
+
+        if (rcp >= cmap->range_length) {
+            continue;
+        }
+        if (cmap->type == LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY) {
+            return cmap->glyph_id_start + rcp;
+        }
+    }
+    return 0;
+}
+
+bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t *font, lv_font_glyph_dsc_t *dsc_out,
+                                   uint32_t unicode_letter, uint32_t unicode_letter_next) {
+    const lv_font_fmt_txt_dsc_t *fdsc = font->dsc;
+    uint32_t gid = glyph_id(fdsc, unicode_letter);
+
+    if (gid == 0) {
+        return false;
+    }
+
+    const lv_font_fmt_txt_glyph_dsc_t *gdsc = &fdsc->glyph_dsc[gid];
+    dsc_out->resolved_font = font;
+    dsc_out->adv_w = (gdsc->adv_w + (1 << 3)) >> 4;
+    dsc_out->box_w = gdsc->box_w;
+    dsc_out->box_h = gdsc->box_h;
+    dsc_out->ofs_x = gdsc->ofs_x;
+    dsc_out->ofs_y = gdsc->ofs_y;
+    dsc_out->bpp = fdsc->bpp;
+    return true;
+}
+
+const uint8_t *lv_font_get_bitmap_fmt_txt(const lv_font_t *font, uint32_t letter) {
+    const lv_font_fmt_txt_dsc_t *fdsc = font->dsc;
+    uint32_t gid = glyph_id(fdsc, letter);
+
+    if (gid == 0) {
+        return NULL;
+    }
+    return &fdsc->glyph_bitmap[fdsc->glyph_dsc[gid].bitmap_index];
+}
+
+void lv_draw_label_dsc_init(lv_draw_label_dsc_t *dsc) {
+    memset(dsc, 0, sizeof(*dsc));
+    dsc->opa = LV_OPA_COVER;
+    dsc->sel_start = LV_DRAW_LABEL_NO_TXT_SEL;
+    dsc->sel_end = LV_DRAW_LABEL_NO_TXT_SEL;
+}
+
+lv_img_dsc_t *lv_canvas_get_img(lv_obj_t *canvas) { return &canvas->img; }
+
+void lv_obj_invalidate_area(const lv_obj_t *obj, const lv_area_t *area) {
+    lv_obj_t *canvas = (lv_obj_t *)obj;
+
+    if (canvas->invalid_count++ == 0) {
+        canvas->invalid = *area;
+        return;
+    }
+    canvas->invalid.x1 = MIN(canvas->invalid.x1, area->x1);
+    canvas->invalid.y1 = MIN(canvas->invalid.y1, area->y1);
+    canvas->invalid.x2 = MAX(canvas->invalid.x2, area->x2);
+    canvas->invalid.y2 = MAX(canvas->invalid.y2, area->y2);
+}
+
+void lv_canvas_draw_text(lv_obj_t *canvas, lv_coord_t x, lv_coord_t y, lv_coord_t max_w,
+                         const lv_draw_label_dsc_t *dsc, const char *txt) {
+    lv_color_t *cbuf = (lv_color_t *)canvas->img.data;
+    lv_coord_t w = canvas->img.header.w;
+    lv_coord_t h = canvas->img.header.h;
+    const lv_font_t *font = dsc->font;
+
+    canvas->fallbacks++;
+
+    lv_coord_t clip_x1 = MAX(x, 0);
+    lv_coord_t clip_x2 = MIN(x + max_w - 1, w - 1);
+    lv_coord_t clip_y1 = MAX(y, 0);
+    lv_coord_t clip_y2 = h - 1;
+
+    for (const char *c = txt; *c != '\0'; c++) {
+        lv_font_glyph_dsc_t g;
+        if (!font->get_glyph_dsc(font, &g, (uint8_t)*c, (uint8_t)c[1])) {
+            continue;
+        }
+
+        const uint8_t *bitmap = font->get_glyph_bitmap(font, (uint8_t)*c);
+        lv_coord_t gx = x + g.ofs_x;
+        lv_coord_t gy = y + (font->line_height - font->base_line) - g.box_h - g.ofs_y;
+
+        for (int row = 0; row < g.box_h; row++) {
+            for (int col = 0; col < g.box_w; col++) {
+                int bit = row * g.box_w + col;
+                lv_coord_t px = gx + col, py = gy + row;
+
+                if ((bitmap[bit / 8] & (0x80 >> (bit % 8))) && px >= clip_x1 && px <= clip_x2 &&
+                    py >= clip_y1 && py <= clip_y2) {
+                    cbuf[py * w + px] = dsc->color;
+                }
+            }
+        }
+
+        x += g.adv_w + dsc->letter_space;
+    }
+
+    // lv_canvas_draw_text() invalidates the whole canvas
+    lv_area_t all = {0, 0, w - 1, h - 1};
+    lv_obj_invalidate_area(canvas, &all);
+}
@@ -0,0 +1,19 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <lvgl.h>
+#include <zephyr/sys/util.h>
+
+// A canvas is just its image; invalidations are collected into one box.
+struct _lv_obj_t {
+    lv_img_dsc_t img;
+    lv_area_t invalid;
+    int invalid_count;
+    // Calls that reached the reference lv_canvas_draw_text()
+    int fallbacks;
+};
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "mono_text.h"
+#include "../assets/custom_fonts.h"
+#include "lvgl_ref.h"
+
+/*
+ * canvas_draw_mono_text() and mono_text_render() against the LVGL drawing
+ * path in lvgl_ref.c, for every printable character and a few labels in each
+ * shipped font, at every position in and around a small canvas. Besides the
+ * pixels, the area the fast path invalidates must cover everything it changed.
+ */
+
+#define SIZE 24
+#define MARGIN 16
+
+static const lv_font_t *const fonts[] = {
+    &pixel_operator_mono,
+    &pixel_operator_mono_8,
+    &pixel_operator_mono_12,
+};
+
+static const char *const labels[] = {"100%", "42", "LOWER", "BASE", "Qwerty~", "{|}_@", "  jg"};
+
+static int failures;
+
+static void fail(const char *what, const lv_font_t *font, const char *txt, int x, int y,
+                 int max_w) {
+    if (failures++ < 10) {
+        printf("FAIL %s: font %d \"%s\" at (%d, %d) max_w %d\n", what, font->line_height, txt, x,
+               y, max_w);
+    }
+}
+
+static void canvas_init(lv_obj_t *canvas, lv_color_t *buf, int w, int h) {
+    memset(canvas, 0, sizeof(*canvas));
+    memset(buf, 0, w * h * sizeof(lv_color_t));
+    canvas->img.header.cf = LV_IMG_CF_TRUE_COLOR;
+    canvas->img.header.w = w;
+    canvas->img.header.h = h;
+    canvas->img.data = (const uint8_t *)buf;
+}
+
+static bool covered(const lv_area_t *area, int x, int y) {
+    return x >= area->x1 && x <= area->x2 && y >= area->y1 && y <= area->y2;
+}
+
+static void check_canvas(const lv_draw_label_dsc_t *dsc, const char *txt, int x, int y,
+                         int max_w) {
+    static lv_color_t fast_buf[SIZE * SIZE], ref_buf[SIZE * SIZE];
+    lv_obj_t fast, ref;
+    lv_coord_t width = mono_text_width(dsc->font, txt);
+
+    canvas_init(&fast, fast_buf, SIZE, SIZE);
+    canvas_init(&ref, ref_buf, SIZE, SIZE);
+
+    canvas_draw_mono_text(&fast, x, y, max_w, dsc, txt);
+    lv_canvas_draw_text(&ref, x, y, max_w, dsc, txt);
+
+    // Text wider than max_w wraps in LVGL and must be left to it
+    if (fast.fallbacks != (width > max_w)) {
+        fail("fallback", dsc->font, txt, x, y, max_w);
+    }
+    if (memcmp(fast_buf, ref_buf, sizeof(fast_buf)) != 0) {
+        fail("pixels", dsc->font, txt, x, y, max_w);
+    }
+    for (int py = 0; py < SIZE; py++) {
+        for (int px = 0; px < SIZE; px++) {
+            if (fast_buf[py * SIZE + px].full != 0 &&
+                (fast.invalid_count == 0 || !covered(&fast.invalid, px, py))) {
+                fail("invalidated area", dsc->font, txt, x, y, max_w);
+                return;
+            }
+        }
+    }
+}
+
+static void check_render(const lv_font_t *font, const char *txt) {
+    enum { W = 64, STRIDE = W / 8, H = 24 };
+    static lv_color_t ref_buf[W * H];
+    uint8_t bits[STRIDE * H];
+    lv_draw_label_dsc_t dsc;
+    lv_obj_t ref;
+
+    lv_draw_label_dsc_init(&dsc);
+    dsc.font = font;
+    dsc.color.full = 1;
+
+    canvas_init(&ref, ref_buf, W, font->line_height);
+    lv_canvas_draw_text(&ref, 0, 0, W, &dsc, txt);
+    mono_text_render(font, txt, bits, STRIDE, W, font->line_height);
+
+    for (int y = 0; y < font->line_height; y++) {
+        for (int x = 0; x < W; x++) {
+            bool set = bits[y * STRIDE + x / 8] & (0x80 >> (x % 8));
+            if (set != (ref_buf[y * W + x].full != 0)) {
+                fail("render", font, txt, 0, 0, W);
+                return;
+            }
+        }
+    }
+}
+
+static void check_text(const lv_font_t *font, const char *txt) {
+    lv_draw_label_dsc_t dsc;
+    lv_coord_t width = 0;
+
+    lv_draw_label_dsc_init(&dsc);
+    dsc.font = font;
+    dsc.color.full = 1;
+
+    for (const char *c = txt; *c != '\0'; c++) {
+        lv_font_glyph_dsc_t g;
+        font->get_glyph_dsc(font, &g, (uint8_t)*c, 0);
+        width += g.adv_w;
+    }
+    if (mono_text_width(font, txt) != width) {
+        fail("width", font, txt, 0, 0, 0);
+    }
+
+    for (int y = -MARGIN; y <= SIZE; y++) {
+        for (int x = -MARGIN; x <= SIZE; x++) {
+            check_canvas(&dsc, txt, x, y, SIZE + MARGIN);
+            check_canvas(&dsc, txt, x, y, width);
+            if (width > 0) {
+                check_canvas(&dsc, txt, x, y, width - 1);
+            }
+        }
+    }
+    check_render(font, txt);
+}
+
+int main(void) {
+    char txt[2] = {0};
+
+    for (size_t f = 0; f < ARRAY_SIZE(fonts); f++) {
+        if (!mono_font_supported(fonts[f])) {
+            fail("font not supported", fonts[f], "", 0, 0, 0);
+            continue;
+        }
+        for (char c = 0x20; c <= 0x7E; c++) {
+            txt[0] = c;
+            check_text(fonts[f], txt);
+        }
+        for (size_t i = 0; i < ARRAY_SIZE(labels); i++) {
+            check_text(fonts[f], labels[i]);
+        }
+    }
+
+    if (failures > 0) {
+        printf("%d failures\n", failures);
+        return 1;
+    }
+    printf("mono text fast path matches the LVGL drawing path\n");
+    return 0;
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "wpm_graph.h"
+
+/*
+ * Built once per window length. Feeds random samples to a graph that is
+ * updated after every push, so it scrolls whenever the scale stays put, and
+ * compares each image with the one a second graph replots from scratch. Runs
+ * every pen width, with a fixed scale and with the window's own minimum and
+ * maximum like the auto-range meter.
+ */
+
+static uint32_t state = 0x2545F491;
+
+static uint32_t random32(void) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+// Small moves and jumps, so segments come out flat, shallow and steep
+static uint8_t next_sample(uint8_t prev) {
+    switch (random32() % 3) {
+    case 0:
+        return prev;
+    case 1:
+        return CLAMP(prev + (int)(random32() % 9) - 4, 0, 100);
+    default:
+        return random32() % 101;
+    }
+}
+
+int main(void) {
+    static struct wpm_graph scrolled, replotted;
+    int failures = 0;
+    int scrolls = 0;
+
+    for (int width = 1; width <= 3; width++) {
+        for (int fixed = 0; fixed <= 1; fixed++) {
+            struct wpm_history history;
+            uint8_t wpm = 0;
+
+            wpm_history_init(&history);
+            wpm_graph_init(&scrolled, 0xFFFFFF);
+
+            for (int n = 0; n < 500 * WPM_HISTORY_LEN; n++) {
+                wpm = next_sample(wpm);
+                wpm_history_push(&history, wpm);
+
+                int min = fixed ? 0 : wpm_history_min(&history);
+                int range = fixed ? 100 : wpm_history_max(&history) - min;
+                range = range == 0 ? 1 : range;
+
+                uint32_t seq = scrolled.seq;
+                bool same_scale = scrolled.valid && min == scrolled.min && range == scrolled.range;
+                scrolls += same_scale && history.seq == seq + 1;
+
+                const lv_img_dsc_t *got = wpm_graph_update(&scrolled, &history, min, range, width);
+                wpm_graph_init(&replotted, 0xFFFFFF);
+                const lv_img_dsc_t *want =
+                    wpm_graph_update(&replotted, &history, min, range, width);
+
+                if (memcmp(got->data, want->data, got->data_size) != 0 && failures++ < 10) {
+                    printf("FAIL len=%d width=%d %s push=%d: scrolled graph differs\n",
+                           WPM_HISTORY_LEN, width, fixed ? "fixed" : "auto", n);
+                }
+            }
+        }
+    }
+
+    if (scrolls == 0) {
+        printf("FAIL len=%d: the graph never scrolled\n", WPM_HISTORY_LEN);
+        failures++;
+    }
+    if (failures > 0) {
+        printf("%d failures\n", failures);
+        return 1;
+    }
+    printf("wpm_graph scrolls like it replots for %d samples (%d scrolls)\n", WPM_HISTORY_LEN,
+           scrolls);
+    return 0;
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "wpm_history.h"
+
+/*
+ * Built once per window length. Pushes random sequences through the ring
+ * buffer and checks every sample, minimum, maximum and latest value against a
+ * brute force scan of a plain copy of the window after each push.
+ */
+
+static uint32_t state = 0x2545F491;
+
+static uint32_t random32(void) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+// Runs of equal, rising, falling and random values, so the deques see ties
+static uint8_t next_sample(uint8_t prev) {
+    switch (random32() % 4) {
+    case 0:
+        return prev;
+    case 1:
+        return prev < 250 ? prev + random32() % 5 : prev;
+    case 2:
+        return prev > 5 ? prev - random32() % 5 : prev;
+    default:
+        return random32() % 256;
+    }
+}
+
+int main(void) {
+    int failures = 0;
+
+    for (int round = 0; round < 200; round++) {
+        struct wpm_history history;
+        uint8_t window[WPM_HISTORY_LEN] = {0};
+        uint8_t wpm = 0;
+
+        wpm_history_init(&history);
+
+        for (int n = 0; n < 20 * WPM_HISTORY_LEN + round; n++) {
+            wpm = next_sample(wpm);
+            wpm_history_push(&history, wpm);
+
+            for (int i = 0; i < WPM_HISTORY_LEN - 1; i++) {
+                window[i] = window[i + 1];
+            }
+            window[WPM_HISTORY_LEN - 1] = wpm;
+
+            uint8_t min = 255, max = 0;
+            bool same = true;
+            for (int i = 0; i < WPM_HISTORY_LEN; i++) {
+                min = window[i] < min ? window[i] : min;
+                max = window[i] > max ? window[i] : max;
+                same &= wpm_history_at(&history, i) == window[i];
+            }
+
+            if (!same || wpm_history_min(&history) != min || wpm_history_max(&history) != max ||
+                wpm_history_latest(&history) != wpm) {
+                if (failures++ < 10) {
+                    printf("FAIL len=%d round=%d push=%d: min %d/%d max %d/%d latest %d/%d%s\n",
+                           WPM_HISTORY_LEN, round, n, wpm_history_min(&history), min,
+                           wpm_history_max(&history), max, wpm_history_latest(&history), wpm,
+                           same ? "" : ", window differs");
+                }
+            }
+        }
+    }
+
+    if (failures > 0) {
+        printf("%d failures\n", failures);
+        return 1;
+    }
+    printf("wpm_history matches brute force for %d samples\n", WPM_HISTORY_LEN);
+    return 0;
+}